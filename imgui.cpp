@@ -3,7 +3,9 @@
 #include <stdio.h>
 
 // Minimal stub for compilation
+#ifndef GImGui // may be redirected to a thread-local by IMGUI_USER_CONFIG
 ImGuiContext* GImGui = nullptr;
+#endif
 
 IMGUI_API ImGuiContext* ImGui::CreateContext(ImFontAtlas* atlas) {
     GImGui = new ImGuiContext();
@@ -0,0 +1,109 @@
+// roro_alloc.h
+// Roro Client - heap allocation accounting and the per-frame scratch arena
+// ---------------------------------------------------------------------------
+// Allocation counting: replacement operator new/delete that bump per-thread counters (count and
+// bytes), so the overlay thread can see exactly what one of its frames allocated without the
+// launcher thread's traffic mixed in. The replacements are defined in the one translation unit
+// that defines RORO_ALLOC_IMPLEMENTATION before including this header. ImGui bypasses operator
+// new; route it through roro_imgui_alloc/roro_imgui_free with ImGui::SetAllocatorFunctions.
+// FrameArena: bump allocator for data that only lives for one frame; reset() at frame start.
+// It grows to the high-water mark at reset, so a steady-state frame never touches the heap.
+// ---------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+struct AllocCounters {
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+};
+
+// Allocations made by the calling thread so far (all zero without RORO_ALLOC_IMPLEMENTATION).
+inline thread_local AllocCounters t_allocs;
+
+inline void roro_count_alloc(size_t n){ t_allocs.count++; t_allocs.bytes += n; }
+inline AllocCounters thread_allocs(){ return t_allocs; }
+
+inline void* roro_imgui_alloc(size_t n, void*){ roro_count_alloc(n); return malloc(n); }
+inline void roro_imgui_free(void* p, void*){ free(p); }
+
+// ------------------------------- Frame arena ----------------------------------------
+class FrameArena {
+public:
+    explicit FrameArena(size_t capacity = 16 * 1024) : cap_(capacity) { buf_ = (unsigned char*)::operator new(cap_); }
+    ~FrameArena(){ releaseSpills(); ::operator delete(buf_); }
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // Valid until the next reset(). Never fails: past capacity it spills to the heap for the
+    // rest of the frame and grows at the next reset.
+    void* alloc(size_t n, size_t align = alignof(std::max_align_t)){
+        size_t at = (used_ + align - 1) & ~(align - 1);
+        if(at + n <= cap_){ used_ = at + n; return buf_ + at; }
+        used_ = at + n; // counts toward the high-water mark
+        // spill blocks are chained through a header so reset() can free them
+        const size_t hdr = sizeof(std::max_align_t);
+        unsigned char* block = (unsigned char*)::operator new(hdr + n);
+        *(void**)block = spills_; spills_ = block;
+        return block + hdr;
+    }
+    template<typename T> T* array(size_t n){ return (T*)alloc(sizeof(T) * n, alignof(T)); }
+
+    // Start of frame: everything handed out is released.
+    void reset(){
+        if(used_ > highWater_) highWater_ = used_;
+        if(spills_){
+            releaseSpills();
+            size_t cap = highWater_ + highWater_ / 2;
+            ::operator delete(buf_);
+            buf_ = (unsigned char*)::operator new(cap); cap_ = cap;
+            grows_++;
+        }
+        used_ = 0;
+    }
+
+    size_t used() const { return used_; }
+    size_t capacity() const { return cap_; }
+    size_t highWater() const { return highWater_ > used_ ? highWater_ : used_; }
+    uint32_t grows() const { return grows_; }
+
+private:
+    void releaseSpills(){
+        while(spills_){ void* next = *(void**)spills_; ::operator delete(spills_); spills_ = next; }
+    }
+
+    unsigned char* buf_ = nullptr;
+    size_t cap_ = 0, used_ = 0, highWater_ = 0;
+    void* spills_ = nullptr;
+    uint32_t grows_ = 0;
+};
+
+// The calling thread's frame arena (the overlay thread resets it at the top of each frame).
+inline FrameArena& frame_arena(){
+    static thread_local FrameArena arena;
+    return arena;
+}
+
+// ------------------------------- Hooks ----------------------------------------------
+#ifdef RORO_ALLOC_IMPLEMENTATION
+#if defined(__GNUC__) && !defined(__clang__)
+// GCC pairs an inlined free() with the builtin operator new it assumes, not these replacements
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void* operator new(size_t n){
+    roro_count_alloc(n);
+    if(void* p = malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(size_t n, const std::nothrow_t&) noexcept { roro_count_alloc(n); return malloc(n ? n : 1); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { free(p); }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
@@ -0,0 +1,554 @@
+// roro_bench.cpp
+// Roro Client - overlay microbenchmarks (portable, no window/GPU/Win32 needed)
+// ---------------------------------------------------------------------------
+// BUILD
+//   g++ -O2 -std=c++17 roro_bench.cpp -I. -o roro_bench
+// USAGE
+//   ./roro_bench [frames]
+//   ./roro_bench --replay roro_session.rrec [runs]   (replay a recorded session headless)
+//   ./roro_bench --selftest                           (portable checks; exit code 1 on any failure)
+// The config schema checks need imgui.h and nlohmann/json.hpp, as the launcher does; add their
+// include paths (-Iimgui -I<json include dir>) or they are reported as skipped.
+// ---------------------------------------------------------------------------
+
+#define RORO_ALLOC_IMPLEMENTATION
+#include "roro_alloc.h"
+#include "roro_clickstats.h"
+#include "roro_input.h"
+#include "roro_latency.h"
+#include "roro_pacing.h"
+#include "roro_persist.h"
+#include "roro_process.h"
+#include "roro_record.h"
+#include "roro_window_state.h"
+
+#if __has_include("imgui.h") && __has_include(<nlohmann/json.hpp>)
+#define RORO_BENCH_CONFIG 1
+#include "roro_config.h"
+#include <nlohmann/json.hpp>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+// ------------------------------- CPS: legacy deque version -------------------------
+// Same logic getCPS() used before ClickStats: trim a deque of time points on every query.
+struct DequeCps {
+    std::deque<uint64_t> clickTimes;
+    void click(uint64_t t){ clickTimes.push_back(t); }
+    int get(uint64_t now){ while(!clickTimes.empty() && now - clickTimes.front() > 1000000000ull) clickTimes.pop_front(); return (int)clickTimes.size(); }
+};
+
+// Deterministic click pattern: ~14 CPS with jitter, bursts every few seconds.
+static uint64_t next_click_gap(uint32_t &rng){
+    rng = rng * 1664525u + 1013904223u;
+    uint64_t base = ((rng >> 8) % 100 < 10) ? 35000000ull : 70000000ull;
+    return base + (rng >> 16) % 20000000ull;
+}
+
+template<typename Click, typename Query>
+static void run_cps(const char* label, int frames, Click &&click, Query &&query){
+    const uint64_t frameNs = 6944444ull; // 144 Hz
+    uint32_t rng = 12345; uint64_t nextClick = next_click_gap(rng);
+    long long sink = 0;
+    uint64_t allocStart = thread_allocs().count;
+    auto t0 = Clock::now();
+    for(int f = 0; f < frames; f++){
+        uint64_t now = (uint64_t)f * frameNs;
+        while(nextClick <= now){ click(nextClick); nextClick += next_click_gap(rng); }
+        sink += query(now);
+    }
+    double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+    printf("%-28s %8.1f ns/frame  %10llu allocs  (checksum %lld)\n", label, ns / frames, (unsigned long long)(thread_allocs().count - allocStart), sink);
+}
+
+static void bench_cps(int frames){
+    printf("== CPS: %d frames at 144 Hz ==\n", frames);
+    DequeCps dq;
+    run_cps("deque getCPS()", frames, [&](uint64_t t){ dq.click(t); }, [&](uint64_t now){ return dq.get(now); });
+    static ClickStats stats; ClickStats* cs = &stats;
+    run_cps("ClickStats 1s", frames, [&](uint64_t t){ cs->click(CLICK_LEFT, t); },
+        [&](uint64_t now){ cs->update(now); return cs->count(CLICK_LEFT); });
+    cs->reset();
+    run_cps("ClickStats all windows", frames, [&](uint64_t t){ cs->click(CLICK_LEFT, t); },
+        [&](uint64_t now){ cs->update(now); return cs->count(CLICK_LEFT) + cs->count(CLICK_LEFT, CLICK_WINDOW_5S) + cs->peak(CLICK_LEFT) + (int)cs->average(CLICK_LEFT); });
+}
+
+// ------------------------------- Session replay ------------------------------------
+// Replays a recording `runs` times; every run must produce the same checksum.
+static int bench_replay(const char* path, int runs){
+    Recording rec;
+    if(!read_recording(path, rec)){ fprintf(stderr, "Not a session recording: %s\n", path); return 1; }
+    printf("== Replay: %s, %zu entries, %d runs ==\n", path, rec.entries.size(), runs);
+    ReplayStats first; double best = 0.0; bool stable = true;
+    for(int r = 0; r < runs; r++){
+        uint64_t allocStart = thread_allocs().count;
+        auto t0 = Clock::now();
+        ReplayStats s = replay_recording(rec);
+        double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+        if(r == 0){ first = s; best = ns; printf("first run: %llu allocs\n", (unsigned long long)(thread_allocs().count - allocStart)); }
+        else { if(ns < best) best = ns; if(s.checksum != first.checksum) stable = false; }
+    }
+    print_replay_stats(first, stdout);
+    printf("best run %.2f ms, %.1f ns per loop iteration, %.0fx real time; checksum %s\n", best / 1e6,
+        first.frames ? best / first.frames : 0.0, best > 0.0 ? first.durationNs / best : 0.0, stable ? "stable" : "DIFFERS between runs");
+    return stable ? 0 : 1;
+}
+
+// ------------------------------- Self-test ----------------------------------------
+static int g_checkFailures = 0;
+static void check(bool ok, const char* what){
+    printf("  %-56s %s\n", what, ok ? "ok" : "FAIL");
+    if(!ok) g_checkFailures++;
+}
+
+// Window edges (a click is in a window up to and including t + window), peak, average, and a
+// button whose ring filled up.
+static void selftest_clicks(){
+    printf("== Click stats ==\n");
+    const uint64_t s1 = 1000000000ull, t0 = 10 * s1;
+    static ClickStats cs;
+    cs.reset();
+    cs.click(CLICK_LEFT, t0); cs.click(CLICK_LEFT, t0 + s1 / 2); cs.click(CLICK_LEFT, t0 + s1);
+    cs.update(t0 + s1);
+    check(cs.count(CLICK_LEFT) == 3 && cs.count(CLICK_RIGHT) == 0, "1 s window includes a click exactly 1 s old");
+    cs.update(t0 + s1 + 1);
+    check(cs.count(CLICK_LEFT) == 2 && cs.count(CLICK_LEFT, CLICK_WINDOW_5S) == 3, "and drops it 1 ns later; 5 s window keeps it");
+    cs.update(t0 + 5 * s1);
+    check(cs.count(CLICK_LEFT, CLICK_WINDOW_5S) == 3, "5 s window includes a click exactly 5 s old");
+    cs.update(t0 + 5 * s1 + 1);
+    check(cs.count(CLICK_LEFT, CLICK_WINDOW_5S) == 2 && cs.count(CLICK_LEFT) == 0, "and drops it 1 ns later");
+    check(cs.peak(CLICK_LEFT) == 3 && cs.total(CLICK_LEFT) == 3, "peak counts the inclusive 1 s span");
+    float avg = cs.average(CLICK_LEFT);
+    check(avg > 0.599f && avg < 0.601f, "average is total over first click to now (3 / 5 s)");
+    cs.reset();
+    cs.click(CLICK_RIGHT, t0); cs.click(CLICK_RIGHT, t0 + s1 / 10);
+    cs.update(t0 + s1 / 5);
+    check(cs.average(CLICK_RIGHT) == 2.0f, "average spans at least 1 s");
+
+    cs.reset();
+    const uint32_t n = ClickStats::CAPACITY + 88;
+    for(uint32_t i = 0; i < n; i++) cs.click(CLICK_LEFT, t0 + (uint64_t)i * 1000000ull); // 1000 CPS for 0.6 s
+    cs.update(t0 + (uint64_t)(n - 1) * 1000000ull);
+    check(cs.count(CLICK_LEFT) == (int)ClickStats::CAPACITY && cs.count(CLICK_LEFT, CLICK_WINDOW_5S) == (int)ClickStats::CAPACITY,
+        "a full ring saturates both windows at CAPACITY");
+    check(cs.total(CLICK_LEFT) == n && cs.peak(CLICK_LEFT) == (int)ClickStats::CAPACITY, "total keeps counting; peak saturates");
+    cs.update(t0 + 7 * s1);
+    check(cs.count(CLICK_LEFT) == 0 && cs.count(CLICK_LEFT, CLICK_WINDOW_5S) == 0, "and both windows empty once it is old");
+}
+
+// SpscRing wrap-around and overflow, then the SyntheticInputSource edge filter into InputState.
+static void selftest_input(){
+    printf("== Input ring ==\n");
+    SpscRing<int, 8> ring;
+    bool pushed = true;
+    for(int i = 0; i < 8; i++) pushed &= ring.push(i);
+    check(pushed && ring.size() == 8, "fills to capacity");
+    check(!ring.push(8) && ring.dropped() == 1 && ring.size() == 8, "full ring drops and counts the new value");
+    int v = -1; bool inOrder = true;
+    for(int i = 0; i < 5; i++) inOrder &= ring.pop(v) && v == i;
+    for(int i = 8; i < 13; i++) inOrder &= ring.push(i); // indices 8..12 wrap onto slots 0..4
+    for(int i = 5; i < 13; i++) inOrder &= ring.pop(v) && v == i;
+    check(inOrder && !ring.pop(v) && ring.size() == 0, "wraps around in FIFO order");
+
+    // one producer thread, one consumer: every value arrives once, in order
+    static SpscRing<uint32_t, 64> xring;
+    const uint32_t count = 200000;
+    std::thread producer([]{ for(uint32_t i = 0; i < count; ){ if(xring.push(i)) i++; else std::this_thread::yield(); } });
+    uint32_t expect = 0, x; bool ordered = true;
+    while(expect < count){
+        if(xring.pop(x)){ ordered &= x == expect; expect++; }
+        else std::this_thread::yield();
+    }
+    producer.join();
+    check(ordered, "two threads: 200k values in order, none lost");
+
+    printf("== Synthetic input source ==\n");
+    static InputRing inputRing;
+    SyntheticInputSource src;
+    check(!src.inject(INPUT_W, true, 1), "inject before start() is refused");
+    src.start(inputRing);
+    bool edges = src.inject(INPUT_W, true, 10);
+    edges &= !src.inject(INPUT_W, true, 11);       // auto-repeat
+    edges &= !src.inject(INPUT_LBUTTON, false, 12); // release without a press
+    edges &= src.inject(INPUT_LBUTTON, true, 13);
+    edges &= src.inject(INPUT_W, false, 14);
+    check(edges, "only true edges are accepted");
+    InputState state; uint64_t lastNs = 0; bool monotonic = true;
+    size_t n = state.drain(inputRing, [&](const InputEvent &ev){ monotonic &= ev.timeNs > lastNs; lastNs = ev.timeNs; });
+    check(n == 3 && monotonic && state.lastEventNs == 14, "drain sees 3 edges in order with their stamps");
+    check(!state.down[INPUT_W] && state.down[INPUT_LBUTTON], "held state follows the edges");
+    src.stop();
+}
+
+// ChildProcess and GameLauncher against stand-in children (/bin/sh), including a launch that
+// leaves no handle (what a store app activation does) and the locator that recovers from it.
+static void selftest_process(){
+#ifdef _WIN32
+    printf("== Process (POSIX stand-ins only, skipped) ==\n");
+#else
+    printf("== Child process ==\n");
+    const std::string sh = "/bin/sh";
+    ChildProcess p;
+    check(p.spawn(sh, {"-c", "exit 3"}) && p.tracked() && p.pid() > 0, "spawn a stand-in child");
+    check(p.wait(-1) && p.exited() && p.exitCode() == 3, "wait returns its exit code");
+    check(p.spawn(sh, {"-c", "sleep 0.3"}) && !p.wait(0) && !p.wait(50), "poll and short wait time out while it runs");
+    check(p.wait(-1) && p.exitCode() == 0, "then see it exit");
+    check(!p.spawn("/nonexistent/roro_game"), "a missing executable fails to spawn");
+
+    // Collects every state change the launcher reports (they arrive on its worker).
+    struct States {
+        std::mutex m; std::vector<ProcessState> seen;
+        GameLauncher::StateFn fn(){ return [this](ProcessState s){ std::lock_guard<std::mutex> lk(m); seen.push_back(s); }; }
+        bool are(std::vector<ProcessState> want){ std::lock_guard<std::mutex> lk(m); return seen == want; }
+    };
+    auto wait_for = [](GameLauncher &g, ProcessState s){
+        for(int i = 0; i < 500 && g.state() != s; i++) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return g.state() == s;
+    };
+
+    printf("== Game launcher ==\n");
+    {
+        GameLauncher g; States st;
+        check(g.launch(sh, {"-c", "sleep 0.3; exit 7"}, st.fn()) && wait_for(g, PROCESS_RUNNING) && g.running() && g.pid() > 0, "launch reaches RUNNING");
+        check(!g.launch(sh, {"-c", "exit 0"}), "no second launch while it runs");
+        check(wait_for(g, PROCESS_EXITED) && !g.running() && g.exitCode() == 7, "EXITED with the game's exit code");
+        check(st.are({PROCESS_STARTING, PROCESS_RUNNING, PROCESS_EXITED}), "states: starting, running, exited");
+    }
+    {
+        GameLauncher g; States st;
+        check(g.launch("/nonexistent/roro_game", {}, st.fn()) && wait_for(g, PROCESS_FAILED), "a missing game is FAILED");
+        check(st.are({PROCESS_STARTING, PROCESS_FAILED}) && g.launch(sh, {"-c", "exit 0"}) && wait_for(g, PROCESS_EXITED), "and can be launched again");
+    }
+    // untracked: the stand-in spawns, then drops its handle like a shell hand-off
+    GameLauncher::SpawnFn handOff = [](ChildProcess &proc, const std::string &path, const std::vector<std::string> &args){
+        if(!proc.spawn(path, args)) return false;
+        proc.untrack();
+        return true;
+    };
+    {
+        GameLauncher g; States st; g.setSpawn(handOff);
+        check(g.launch(sh, {"-c", "exit 0"}, st.fn()) && wait_for(g, PROCESS_UNTRACKED) && !g.running(), "untracked launch is UNTRACKED, not running");
+        check(g.launch(sh, {"-c", "exit 0"}) && wait_for(g, PROCESS_UNTRACKED), "and does not block the next launch");
+        check(st.are({PROCESS_STARTING, PROCESS_UNTRACKED}), "states: starting, launched");
+    }
+    {
+        // the locator finds the game by name (here: the stand-in itself) and it is watched after all
+        ChildProcess game;
+        game.spawn(sh, {"-c", "sleep 0.4"});
+        long gamePid = game.pid();
+        GameLauncher g; States st; g.setSpawn(handOff);
+        std::atomic<int> polls{0};
+        check(g.launch(sh, {"-c", "exit 0"}, st.fn(), [&]{ return ++polls >= 3 ? gamePid : 0; }, 5000, 20) && wait_for(g, PROCESS_RUNNING) && g.pid() == gamePid, "locator attaches to the game after an untracked launch");
+        game.wait(-1); // it is this process's child: whichever side reaps it, both see it gone
+        check(wait_for(g, PROCESS_EXITED), "and the launcher sees it exit");
+        check(st.are({PROCESS_STARTING, PROCESS_UNTRACKED, PROCESS_RUNNING, PROCESS_EXITED}), "states: starting, launched, running, exited");
+    }
+    {
+        GameLauncher g; g.setSpawn(handOff);
+        check(g.launch(sh, {"-c", "exit 0"}, nullptr, []{ return 0L; }, 100, 20) && wait_for(g, PROCESS_UNTRACKED), "a locator that finds nothing leaves it UNTRACKED");
+    }
+    {
+        // launch again while the first worker is still polling its locator: that worker is joined
+        // before the second locator replaces it, and only the second one is used from then on
+        ChildProcess game;
+        game.spawn(sh, {"-c", "sleep 0.4"});
+        long gamePid = game.pid();
+        GameLauncher g; g.setSpawn(handOff);
+        std::atomic<int> firstPolls{0}, secondPolls{0};
+        bool first = g.launch(sh, {"-c", "exit 0"}, nullptr, [&]{ firstPolls++; return 0L; }, 5000, 20);
+        for(int i = 0; i < 200 && firstPolls < 2; i++) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        bool second = g.launch(sh, {"-c", "exit 0"}, nullptr, [&]{ secondPolls++; return gamePid; }, 5000, 20);
+        int polledBefore = firstPolls;
+        check(first && second && polledBefore >= 2, "second untracked launch while the first is locating");
+        check(wait_for(g, PROCESS_RUNNING) && g.pid() == gamePid && secondPolls >= 1 && firstPolls == polledBefore, "only the second locator runs after it");
+        game.wait(-1);
+        check(wait_for(g, PROCESS_EXITED), "and the game it found is watched to exit");
+    }
+    ChildProcess sleeper;
+    sleeper.spawn("/bin/sleep", {"0.3"});
+    check(find_process_by_name("sleep") > 0 && find_process_by_name("no_such_roro_process") == 0, "find_process_by_name finds a running process by name");
+    sleeper.wait(-1);
+#endif
+}
+
+static bool file_text(const char* path, std::string &out){
+    FILE* f = fopen(path, "rb");
+    if(!f) return false;
+    char buf[256]; size_t n; out.clear();
+    while((n = fread(buf, 1, sizeof(buf), f)) > 0) out.append(buf, n);
+    fclose(f);
+    return true;
+}
+
+// Edges are charged to the first presented frame after them; a skipped frame's edges and edges
+// from before the overlay was shown again are not sampled. Percentiles on a known spread.
+static void selftest_latency(){
+    printf("== Input latency ==\n");
+    const uint64_t ms = 1000000ull, t0 = 1000 * ms;
+    static LatencyTracker lt; // 100 KB of samples and histogram: kept off the stack
+    lt.reset(); lt.restart(t0);
+    InputEvent ev; ev.code = INPUT_LBUTTON; ev.down = 1;
+    ev.timeNs = t0 + 1 * ms; lt.input(ev);
+    lt.skipped();                                   // render-on-change: nothing new shown
+    ev.timeNs = t0 + 2 * ms; lt.input(ev);
+    ev.timeNs = t0 + 3 * ms; lt.input(ev);
+    lt.presented(7, t0 + 5 * ms);
+    LatencyStats st = lt.stats();
+    check(st.count == 2 && lt.unshown() == 1, "skipped frame's edge unshown; later edges sampled");
+    check(lt.at(0).frame == 7 && lt.at(1).frame == 7 && lt.at(0).presentNs == t0 + 5 * ms, "both charged to the next presented frame");
+    check(st.minMs > 1.99f && st.minMs < 2.01f && st.maxMs > 2.99f && st.maxMs < 3.01f, "latency is present time minus edge time");
+    lt.presented(8, t0 + 6 * ms);
+    check(lt.stats().count == 2, "a frame with no new edges samples nothing");
+
+    lt.restart(t0 + 100 * ms);                      // shown again after idling
+    ev.timeNs = t0 + 50 * ms; lt.input(ev);         // captured while hidden
+    lt.presented(9, t0 + 110 * ms);
+    check(lt.stats().count == 2 && lt.unshown() == 1, "edges from while idle are dropped, not sampled");
+
+    lt.reset(); lt.restart(t0);
+    for(int i = 0; i < 100; i++){                   // one edge per 0.1 ms bucket: 0.05 .. 9.95 ms
+        uint64_t t = t0 + (uint64_t)i * 20 * ms;
+        ev.timeNs = t; lt.input(ev);
+        lt.presented((uint32_t)i, t + (uint64_t)i * LatencyTracker::BUCKET_NS + LatencyTracker::BUCKET_NS / 2);
+    }
+    st = lt.stats();
+    check(st.count == 100 && lt.unshown() == 0 && lt.bucket(0) == 1 && lt.bucket(99) == 1, "histogram: one sample per bucket");
+    check(st.minMs > 0.049f && st.minMs < 0.051f && st.maxMs > 9.949f && st.maxMs < 9.951f, "min and max are exact");
+    check(st.p50Ms > 4.99f && st.p50Ms < 5.01f && st.p99Ms > 9.89f && st.p99Ms < 9.91f, "p50 5.0 ms, p99 9.9 ms (bucket upper bounds)");
+}
+
+// FrameScheduler on injected frame start times (due()/started() are wait() minus the sleep).
+static void selftest_pacing(){
+    printf("== Frame pacing ==\n");
+    const uint64_t ms = 1000000ull, us = 1000ull, t0 = 1000 * ms;
+    auto near = [](float v, float want){ return v > want - 0.001f && v < want + 0.001f; };
+    FrameScheduler fs;
+    PacingConfig fixed; fixed.mode = PACING_FIXED; fixed.targetHz = 100.0f; // 10 ms period
+    fs.configure(fixed, 0.0f);
+    bool waits = fs.due(t0) == t0;                    fs.started(t0);            // first frame: on time
+    waits = waits && fs.due(t0 + 5 * ms) == t0 + 10 * ms; fs.started(t0 + 10 * ms); // early: sleeps to its deadline
+    waits = waits && fs.due(t0 + 20 * ms + 200 * us) == t0 + 20 * ms; fs.started(t0 + 20 * ms + 200 * us); // late within tolerance
+    fs.due(t0 + 31 * ms); fs.started(t0 + 31 * ms);  // 1 ms late: missed
+    bool resynced = fs.due(t0 + 55 * ms) == 0;       fs.started(t0 + 55 * ms);  // more than a period behind: missed, resync
+    waits = waits && fs.due(t0 + 60 * ms) == t0 + 65 * ms; // deadlines continue from the resync
+    PacingStats st = fs.stats();
+    check(waits && resynced, "fixed: waits for deadlines, resyncs a period behind");
+    check(st.frames == 5 && st.missed == 2, "fixed: misses only past the 0.5 ms tolerance");
+    // start errors 0, 0, 0.2, 1, 0 ms: mean 0.24, deviation sqrt(0.208 - 0.0576)
+    check(near(st.maxLateMs, 1.0f) && near(st.jitterMs, (float)std::sqrt(0.1504)), "fixed: jitter and max late from start errors");
+
+    PacingConfig display; display.mode = PACING_DISPLAY;
+    fs.configure(display, 100.0f);
+    check(fs.stats().frames == 0 && fs.due(t0) == 0, "display: configure resets, never waits");
+    fs.started(t0); fs.started(t0 + 10 * ms); fs.started(t0 + 20 * ms);
+    fs.started(t0 + 45 * ms);                        // a refresh went by: missed, 15 ms error
+    fs.skipped(); fs.started(t0 + 100 * ms);         // render-on-change skip: gap not measured
+    fs.started(t0 + 110 * ms);
+    fs.resync(); fs.started(t0 + 500 * ms);          // shown again after idling: gap not measured
+    fs.started(t0 + 510 * ms);
+    st = fs.stats();
+    check(st.frames == 5 && st.missed == 1, "display: skipped and idle gaps are not frames or misses");
+    check(near(st.maxLateMs, 15.0f) && near(st.jitterMs, 6.0f), "display: errors 0,0,15,0,0 ms give jitter 6 ms");
+}
+
+// write_file_atomic, the persister's debounce (a burst of submits is one write) and its watcher
+// (its own writes are not reloads; an external edit is).
+static void selftest_persist(){
+    printf("== Config persistence ==\n");
+    const char* path = "roro_selftest_config.txt";
+    std::string text;
+    bool wrote = write_file_atomic(path, "old") && write_file_atomic(path, "new");
+    FILE* tmp = fopen("roro_selftest_config.txt.tmp", "rb");
+    check(wrote && file_text(path, text) && text == "new" && !tmp, "write_file_atomic replaces the file, leaves no temp");
+    if(tmp) fclose(tmp);
+
+    std::atomic<int> writes{0}, reloads{0};
+    ConfigPersister<std::string> persist(path,
+        [&](const std::string &v){ writes++; return v; },
+        [](const std::string &t, std::string &v){ v = t; return true; });
+    persist.start([&]{ reloads++; }, std::chrono::milliseconds(500), std::chrono::milliseconds(50));
+    for(int i = 1; i <= 5; i++){ persist.submit("burst " + std::to_string(i)); std::this_thread::sleep_for(std::chrono::milliseconds(50)); }
+    bool early = writes == 0; // 250 ms after the first submit: still debouncing
+    std::this_thread::sleep_for(std::chrono::milliseconds(900));
+    check(early && writes == 1 && file_text(path, text) && text == "burst 5", "debounce turns a burst of saves into one write");
+    std::string reloaded;
+    check(reloads == 0 && !persist.takeReloaded(reloaded), "watcher ignores the persister's own write");
+    std::this_thread::sleep_for(std::chrono::milliseconds(20)); // a newer mtime on coarse-grained file systems
+    if(FILE* f = fopen(path, "wb")){ fputs("edited", f); fclose(f); }
+    for(int i = 0; i < 100 && !reloads; i++) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    check(persist.takeReloaded(reloaded) && reloaded == "edited" && writes == 1, "and picks up an external edit");
+    persist.stop();
+    remove(path);
+}
+
+// AppConfig through roro_config_schema.h: JSON and binary round trips, defaults for missing or
+// mistyped JSON fields, and binaries of another schema or JSON version rejected.
+#ifdef RORO_BENCH_CONFIG
+static bool same_panel(const PanelConfig &a, const PanelConfig &b){
+    return a.enabled == b.enabled && a.background == b.background && a.scale == b.scale && a.movable == b.movable
+        && memcmp(a.color, b.color, sizeof(a.color)) == 0 && memcmp(a.bgColor, b.bgColor, sizeof(a.bgColor)) == 0
+        && a.pos.x == b.pos.x && a.pos.y == b.pos.y;
+}
+static bool same_config(const AppConfig &a, const AppConfig &b){
+    if(a.minecraftPath != b.minecraftPath || a.overlayClickThrough != b.overlayClickThrough || a.overlayAlwaysOnTop != b.overlayAlwaysOnTop
+       || a.overlayRenderOnChange != b.overlayRenderOnChange || a.overlayFrameStats != b.overlayFrameStats || a.overlayBatchedHud != b.overlayBatchedHud
+       || a.overlayShowOnStart != b.overlayShowOnStart || a.overlayFollowGame != b.overlayFollowGame || a.overlayMetricsExport != b.overlayMetricsExport
+       || a.overlayPacing.mode != b.overlayPacing.mode || a.overlayPacing.targetHz != b.overlayPacing.targetHz || a.panels.size() != b.panels.size()) return false;
+    for(const auto &kv : a.panels){
+        auto it = b.panels.find(kv.first);
+        if(it == b.panels.end() || !same_panel(kv.second, it->second)) return false;
+    }
+    return true;
+}
+
+static void selftest_config(){
+    printf("== Config schema ==\n");
+    AppConfig c; // every field off its default
+    c.minecraftPath = "C:\\Games\\mc \"bedrock\".exe"; c.overlayClickThrough = true; c.overlayAlwaysOnTop = false;
+    c.overlayRenderOnChange = true; c.overlayFrameStats = true; c.overlayBatchedHud = false; c.overlayShowOnStart = false;
+    c.overlayFollowGame = false; c.overlayMetricsExport = true;
+    c.overlayPacing.mode = PACING_FIXED; c.overlayPacing.targetHz = 143.5f;
+    PanelConfig p; p.enabled = false; p.background = false; p.scale = 1.3f; p.movable = false; p.pos = ImVec2(12.25f, -7.0f);
+    p.color[0] = 0.1f; p.color[3] = 0.7f; p.bgColor[1] = 0.333333f;
+    c.panels["FPS COUNTER"] = p;
+    p.scale = 0.1f; p.pos = ImVec2(1e-3f, 4096.5f);
+    c.panels["CPS COUNTER"] = p;
+
+    AppConfig fromJson;
+    read_config_json(nlohmann::json::parse(config_to_json(c)), fromJson);
+    check(same_config(c, fromJson), "JSON round trip keeps every field");
+    AppConfig fromBinary; uint64_t stamp = 0;
+    std::string bin = config_to_binary(c, 1234);
+    check(config_from_binary(bin, fromBinary, &stamp) && stamp == 1234 && same_config(c, fromBinary), "binary round trip keeps every field and the stamp");
+
+    const char* edited = R"({"minecraftPath": 5, "overlayAlwaysOnTop": "no", "overlayFrameStats": true,
+        "overlayPacing": {"mode": "warp", "targetHz": "fast"},
+        "panels": {"WATERMARK": {"scale": "big", "color": [0.5, "x"], "pos": [3]}, "junk": 7}})";
+    AppConfig d, defaults;
+    read_config_json(nlohmann::json::parse(edited), d);
+    const PanelConfig &w = d.panels["WATERMARK"];
+    check(d.minecraftPath == defaults.minecraftPath && d.overlayAlwaysOnTop && d.overlayFrameStats && d.overlayFollowGame,
+        "mistyped and missing fields keep their defaults");
+    check(d.overlayPacing.mode == defaults.overlayPacing.mode && d.overlayPacing.targetHz == defaults.overlayPacing.targetHz,
+        "unknown enum name and mistyped number too");
+    check(d.panels.size() == 1 && w.scale == 1.0f && w.color[0] == 0.5f && w.color[1] == 1.0f && w.pos.x == 3.0f && w.pos.y == 100.0f,
+        "per element inside panels and arrays");
+
+    AppConfig untouched = c, r;
+    std::string otherSchema = bin; otherSchema[8] ^= 1; // ConfigBinaryHeader::schemaHash
+    std::string profile = config_to_binary(c.panels);
+    std::map<std::string, PanelConfig> panels;
+    check(!config_from_binary(otherSchema, r) && !config_from_binary(profile, r) && !config_from_binary(bin, panels),
+        "binary of another schema is rejected");
+    check(config_from_binary(profile, panels) && panels.size() == 2 && same_panel(panels["CPS COUNTER"], c.panels["CPS COUNTER"]),
+        "HUD profile reads back as a panels map");
+    profile[8] ^= 1;
+    check(!config_from_binary(profile, panels) && panels.size() == 2, "profile with another schema hash is rejected");
+    check(!config_from_binary(bin.substr(0, bin.size() - 1), r) && !config_from_binary(bin + "x", r), "truncated or trailing bytes are rejected");
+    check(!read_config_cache(bin, 1235, untouched) && same_config(untouched, c) && read_config_cache(bin, 1234, r) && same_config(r, c),
+        "config cache used only for its JSON stamp");
+}
+#else
+static void selftest_config(){ printf("== Config schema ==\n  skipped: build with imgui.h and nlohmann/json.hpp on the include path\n"); }
+#endif
+
+// Record -> read -> replay round trip: a button held when recording starts is held in replay but
+// is not a click; its release and the next press are. A torn last entry is ignored. Then a hold
+// across the overlay going idle.
+static void selftest_record(){
+    printf("== Recording ==\n");
+    const char* path = "roro_selftest.rrec";
+    const uint64_t ms = 1000000ull, t0 = 1000 * ms;
+    InputState held; held.down[INPUT_LBUTTON] = true;
+    static SessionRecorder rec; // 4 KB block: kept off the stack
+    bool started = rec.start(path, t0, held);
+    InputEvent ev; ev.code = INPUT_LBUTTON;
+    rec.frame(t0 + 10 * ms); rec.endFrame(true, 0);
+    ev.timeNs = t0 + 20 * ms; ev.down = 0; rec.input(ev);
+    rec.frame(t0 + 30 * ms); rec.endFrame(true, 0);
+    ev.timeNs = t0 + 40 * ms; ev.down = 1; rec.input(ev);
+    rec.frame(t0 + 50 * ms); rec.endFrame(false, 0);
+    rec.stop();
+    check(started && !rec.failed() && rec.entries() == 5, "recorder writes frames and edges only");
+    if(FILE* f = fopen(path, "ab")){ fwrite("torn", 1, 4, f); fclose(f); }
+    Recording r;
+    bool read = read_recording(path, r);
+    check(read && r.header.held == 1u << INPUT_LBUTTON && r.entries.size() == 5, "held keys in the header; torn tail dropped");
+    bool heldFirst = false; int n = 0;
+    ReplayStats st = replay_recording(r, [&](const ReplayFrame &f){ if(n++ == 0) heldFirst = f.input->down[INPUT_LBUTTON]; });
+    check(heldFirst && st.heldFrames[INPUT_LBUTTON] == 2, "replay starts with the button held");
+    check(st.clicks[CLICK_LEFT] == 1 && st.edges == 2, "initial hold is not a click; the next press is");
+
+    // hold -> hide -> resume, as the overlay loop records it: the edges drained when it goes idle
+    // count, and nothing stays held afterwards
+    held.down[INPUT_LBUTTON] = false;
+    started = rec.start(path, t0, held);
+    ev.timeNs = t0 + 5 * ms; ev.code = INPUT_LBUTTON; ev.down = 1; rec.input(ev);
+    rec.frame(t0 + 10 * ms); rec.endFrame(true, 0);
+    ev.timeNs = t0 + 15 * ms; ev.code = INPUT_RBUTTON; rec.input(ev); // still in the ring at hide time
+    rec.idle(t0 + 20 * ms);
+    rec.resume(t0 + 100 * ms);
+    rec.frame(t0 + 110 * ms); rec.endFrame(true, 0);
+    rec.frame(t0 + 120 * ms); rec.endFrame(true, 0);
+    rec.stop();
+    read = started && !rec.failed() && read_recording(path, r);
+    st = replay_recording(r);
+    check(read && st.frames == 3 && st.heldFrames[INPUT_LBUTTON] == 1 && st.heldFrames[INPUT_RBUTTON] == 0, "keys held at hide are released in replay");
+    check(st.clicks[CLICK_LEFT] == 1 && st.clicks[CLICK_RIGHT] == 1 && st.edges == 2, "clicks drained at hide are counted");
+    remove(path);
+}
+
+// The overlay's own per-frame update (apply_overlay_window) over 2000 frames: click-through on
+// at 1/4, always-on-top off at 1/2, click-through off at 3/4. 2 calls for the first frame plus
+// one per change, where re-applying every frame would make 4000.
+static void selftest_window_state(){
+    printf("== Window state ==\n");
+    const int frames = 2000;
+    MockWindowBackend backend;
+    WindowStateCache cache(backend);
+    WindowState want;
+    for(int f = 0; f < frames; f++){
+        bool clickThrough = f >= frames / 4 && f < frames * 3 / 4;
+        bool alwaysOnTop = f < frames / 2;
+        apply_overlay_window(cache, want, alwaysOnTop, clickThrough);
+    }
+    check(backend.total() == 5 && backend.topmostCalls == 2 && backend.styleCalls == 3 && backend.rectCalls == 0,
+        "5 platform calls (topmost+style, style, topmost, style)");
+    check(cache.calls() == 5, "cache counts the same calls");
+    check(!backend.state.clickThrough && backend.state.layered && !backend.state.topmost, "final state: layered stays, rest follows config");
+}
+
+static int run_selftest(){
+    selftest_clicks();
+    selftest_input();
+    selftest_process();
+    selftest_latency();
+    selftest_pacing();
+    selftest_persist();
+    selftest_config();
+    selftest_record();
+    selftest_window_state();
+    printf("%s (%d failed)\n", g_checkFailures ? "FAIL" : "ok", g_checkFailures);
+    return g_checkFailures ? 1 : 0;
+}
+
+int main(int argc, char** argv){
+    if(argc > 1 && strcmp(argv[1], "--selftest") == 0) return run_selftest();
+    if(argc > 2 && strcmp(argv[1], "--replay") == 0) return bench_replay(argv[2], argc > 3 && atoi(argv[3]) > 0 ? atoi(argv[3]) : 20);
+    int frames = argc > 1 ? atoi(argv[1]) : 1000000;
+    if(frames <= 0) frames = 1000000;
+    bench_cps(frames);
+    return 0;
+}
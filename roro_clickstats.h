@@ -0,0 +1,83 @@
+// roro_clickstats.h
+// Roro Client - allocation-free click statistics for the CPS COUNTER
+// ---------------------------------------------------------------------------
+// Each button keeps its recent click timestamps in a fixed ring. Every reporting window
+// (1 s, 5 s) owns a tail index that only ever moves forward, so a query is O(1) amortized and
+// nothing is allocated after construction. Session totals, peak 1 s CPS and session average
+// are plain counters next to the rings.
+// Timestamps are steady_clock nanoseconds (see roro_input.h), fed in non-decreasing order.
+// ---------------------------------------------------------------------------
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+enum ClickButton { CLICK_LEFT, CLICK_RIGHT, CLICK_BUTTON_COUNT };
+enum ClickWindow { CLICK_WINDOW_1S, CLICK_WINDOW_5S, CLICK_WINDOW_COUNT };
+
+static constexpr uint64_t CLICK_WINDOW_NS[CLICK_WINDOW_COUNT] = { 1000000000ull, 5000000000ull };
+
+class ClickStats {
+public:
+    // Ring capacity per button; bounds the count a window can report (512 over 5 s = 102 CPS).
+    static constexpr uint32_t CAPACITY = 512;
+
+    ClickStats(){ reset(); }
+
+    void reset(){
+        memset(btn_, 0, sizeof(btn_));
+        nowNs_ = 0;
+    }
+
+    void click(ClickButton b, uint64_t tNs){
+        Button &s = btn_[b];
+        if(tNs < s.lastNs) tNs = s.lastNs; // keep the ring sorted even if a source hiccups
+        s.t[s.head & (CAPACITY - 1)] = tNs;
+        s.head++; s.total++; s.lastNs = tNs;
+        if(s.total == 1) s.firstNs = tNs;
+        for(int w = 0; w < CLICK_WINDOW_COUNT; w++) trim(s, w, tNs);
+        uint32_t inSecond = s.head - s.tail[CLICK_WINDOW_1S];
+        if(inSecond > s.peak) s.peak = inSecond;
+    }
+
+    // Expire clicks that fell out of each window as of `nowNs`. Call once per frame before reading.
+    void update(uint64_t nowNs){
+        nowNs_ = nowNs;
+        for(int b = 0; b < CLICK_BUTTON_COUNT; b++)
+            for(int w = 0; w < CLICK_WINDOW_COUNT; w++) trim(btn_[b], w, nowNs);
+    }
+
+    // Clicks inside the window ending at the last update().
+    int count(ClickButton b, ClickWindow w = CLICK_WINDOW_1S) const { return (int)(btn_[b].head - btn_[b].tail[w]); }
+    // Clicks per second over the window.
+    float rate(ClickButton b, ClickWindow w) const { return count(b, w) * 1e9f / (float)CLICK_WINDOW_NS[w]; }
+    // Highest number of clicks seen in any 1 s span this session.
+    int peak(ClickButton b) const { return (int)btn_[b].peak; }
+    uint64_t total(ClickButton b) const { return btn_[b].total; }
+    // Session average CPS, from the first click to the last update() (at least one second).
+    float average(ClickButton b) const {
+        const Button &s = btn_[b];
+        if(!s.total) return 0.0f;
+        uint64_t span = nowNs_ > s.firstNs ? nowNs_ - s.firstNs : 0;
+        if(span < 1000000000ull) span = 1000000000ull;
+        return (float)((double)s.total * 1e9 / (double)span);
+    }
+
+private:
+    struct Button {
+        uint64_t t[CAPACITY];
+        uint32_t head;                       // next write position (monotonic)
+        uint32_t tail[CLICK_WINDOW_COUNT];   // oldest click still inside each window
+        uint32_t peak;
+        uint64_t total, firstNs, lastNs;
+    };
+
+    static void trim(Button &s, int w, uint64_t nowNs){
+        uint32_t &tail = s.tail[w];
+        if(s.head - tail > CAPACITY) tail = s.head - CAPACITY; // overwritten: saturate
+        while(tail != s.head && nowNs > s.t[tail & (CAPACITY - 1)] + CLICK_WINDOW_NS[w]) tail++;
+    }
+
+    Button btn_[CLICK_BUTTON_COUNT];
+    uint64_t nowNs_;
+};
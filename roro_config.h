@@ -0,0 +1,76 @@
+// roro_config.h
+// Roro Client - the launcher's config (roro_config.json) and its schema
+// ---------------------------------------------------------------------------
+// AppConfig is what roro_config.json holds. Its fields are listed once, in ConfigSchema, and the
+// JSON file, the binary cache (roro_config.bin) and HUD profiles all come from that list
+// (roro_config_schema.h). PanelConfig and the built-in PANEL_NAMES live in roro_panels.h.
+// ---------------------------------------------------------------------------
+#pragma once
+
+#include "roro_config_schema.h"
+#include "roro_pacing.h"
+#include "roro_panels.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+
+struct AppConfig {
+    std::string minecraftPath = ""; // path to bedrock exe
+    bool overlayClickThrough = false; // if true, overlay won't receive mouse input
+    bool overlayAlwaysOnTop = true;
+    bool overlayRenderOnChange = false; // skip overlay frames whose content would be identical
+    bool overlayFrameStats = false;     // FPS COUNTER also shows 1% low, p99 and a frame-time graph
+    bool overlayBatchedHud = true;      // draw idle panels into one draw list; windows only while dragged
+    bool overlayShowOnStart = true;     // otherwise the overlay window is only created when first shown
+    bool overlayFollowGame = true;      // overlay only runs while the launched game is running
+    bool overlayMetricsExport = false;  // publish HUD metrics to shared memory (roro_metrics.h)
+    PacingConfig overlayPacing;         // uncapped / fixed target rate / match display refresh
+    std::map<std::string, PanelConfig> panels;
+};
+
+// Config fields, named once; JSON and the binary cache/profile formats come from these
+// (roro_config_schema.h). PanelConfig's list is in roro_panels.h.
+template<> struct ConfigSchema<PacingConfig> {
+    template<typename S, typename V> static void fields(S &p, V &v){
+        v("mode", p.mode, PACING_MODE_NAMES, PACING_MODE_COUNT);
+        v("targetHz", p.targetHz);
+    }
+};
+template<> struct ConfigSchema<AppConfig> {
+    template<typename S, typename V> static void fields(S &c, V &v){
+        v("minecraftPath", c.minecraftPath);
+        v("overlayClickThrough", c.overlayClickThrough);
+        v("overlayAlwaysOnTop", c.overlayAlwaysOnTop);
+        v("overlayRenderOnChange", c.overlayRenderOnChange);
+        v("overlayFrameStats", c.overlayFrameStats);
+        v("overlayBatchedHud", c.overlayBatchedHud);
+        v("overlayShowOnStart", c.overlayShowOnStart);
+        v("overlayFollowGame", c.overlayFollowGame);
+        v("overlayMetricsExport", c.overlayMetricsExport);
+        v("overlayPacing", c.overlayPacing);
+        v("panels", c.panels);
+    }
+};
+
+// Every built-in panel gets an entry: all of them, enabled, when the config has none; otherwise
+// ones added after the config was written show up in Settings, disabled. Applied to whatever
+// replaces g_config (file, binary cache or hot reload), never written back unless saved.
+inline void add_builtin_panels(AppConfig &c){
+    bool fresh = c.panels.empty();
+    for(auto &name : PANEL_NAMES){
+        if(c.panels.count(name)) continue;
+        PanelConfig p; p.enabled = fresh; p.pos = ImVec2(50.0f, 50.0f+20.0f);
+        c.panels[name] = p;
+    }
+}
+
+// roro_config.bin: used only if it is a complete binary of this schema written for this exact
+// version of roro_config.json (`stamp`); false leaves `out` untouched.
+inline bool read_config_cache(const std::string &data, uint64_t stamp, AppConfig &out){
+    AppConfig c; uint64_t cachedStamp = 0;
+    if(!config_from_binary(data, c, &cachedStamp) || cachedStamp != stamp) return false;
+    out = std::move(c);
+    return true;
+}
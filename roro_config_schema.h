@@ -0,0 +1,306 @@
+// roro_config_schema.h
+// Roro Client - config schema: fields listed once, JSON and binary serializers generated from it
+// ---------------------------------------------------------------------------
+// A config struct lists its fields once, in ConfigSchema<T>::fields(), as (name, member) pairs.
+// Every serializer is a visitor with one overload per field type: bool, float, float[N], ImVec2,
+// std::string, enums stored by name, nested schema structs, and std::map<std::string, T>.
+// - JSON read:  walks an already parsed document (nlohmann::json, or anything with the same
+//               interface) by reference. Missing or mistyped fields keep the struct's default.
+// - JSON write: streams text straight into a string, no DOM.
+// - Binary:     fields in schema order, fixed width, host byte order (little-endian on every
+//               target we build for). Decodes straight into the structs from one buffer.
+// The binary header carries a hash of the schema (names and types), so a binary written before a
+// field was added, removed or retyped is rejected rather than misread.
+// ---------------------------------------------------------------------------
+#pragma once
+
+#include "imgui.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <utility>
+
+// Specialize with:
+//   template<typename S, typename V> static void fields(S &s, V &v){ v("name", s.member); ... }
+// S is T or const T. Enums stored by name: v("name", s.member, NAMES, COUNT).
+template<typename T> struct ConfigSchema;
+
+// ------------------------------- JSON write -----------------------------------------
+// Shortest text that reads back as the same float; integral values keep a ".0".
+inline void json_append_float(std::string &out, float f){
+    if(!std::isfinite(f)){ out += "null"; return; }
+    char buf[32];
+    for(int prec = 6; prec <= 9; prec++){
+        snprintf(buf, sizeof(buf), "%.*g", prec, f);
+        if(strtof(buf, nullptr) == f) break;
+    }
+    out += buf;
+    if(!strpbrk(buf, ".eE")) out += ".0";
+}
+
+inline void json_append_string(std::string &out, const char* s, size_t n){
+    out += '"';
+    for(size_t i = 0; i < n; i++){
+        unsigned char c = (unsigned char)s[i];
+        switch(c){
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if(c < 0x20){ char esc[8]; snprintf(esc, sizeof(esc), "\\u%04x", c); out += esc; }
+                else out += (char)c;
+        }
+    }
+    out += '"';
+}
+inline void json_append_string(std::string &out, const std::string &s){ json_append_string(out, s.data(), s.size()); }
+
+// Four-space indented objects in schema order; number arrays stay on one line.
+struct JsonFieldWriter {
+    std::string &out;
+    int indent;
+    bool first = true;
+
+    void operator()(const char* name, const bool &v){ key(name); out += v ? "true" : "false"; }
+    void operator()(const char* name, const float &v){ key(name); json_append_float(out, v); }
+    void operator()(const char* name, const std::string &v){ key(name); json_append_string(out, v); }
+    void operator()(const char* name, const ImVec2 &v){ float xy[2] = { v.x, v.y }; (*this)(name, xy); }
+    template<size_t N> void operator()(const char* name, const float (&v)[N]){
+        key(name); out += '[';
+        for(size_t i = 0; i < N; i++){ if(i) out += ", "; json_append_float(out, v[i]); }
+        out += ']';
+    }
+    template<typename E> void operator()(const char* name, const E &v, const char* const* names, int count){
+        key(name); json_append_string(out, (int)v >= 0 && (int)v < count ? names[(int)v] : "");
+    }
+    template<typename T> void operator()(const char* name, const std::map<std::string, T> &m){
+        key(name); out += '{';
+        JsonFieldWriter w{out, indent + 1};
+        for(const auto &kv : m){ w.key(kv.first); w.object(kv.second); }
+        w.close();
+    }
+    template<typename T> void operator()(const char* name, const T &v){ key(name); object(v); }
+
+    template<typename T> void object(const T &v){
+        out += '{';
+        JsonFieldWriter w{out, indent + 1};
+        ConfigSchema<T>::fields(v, w);
+        w.close();
+    }
+
+private:
+    void key(const std::string &name){
+        out += first ? "\n" : ",\n"; first = false;
+        out.append((size_t)indent * 4, ' ');
+        json_append_string(out, name); out += ": ";
+    }
+    // Closing brace of the object this writer filled (indented one level out).
+    void close(){
+        if(!first){ out += '\n'; out.append((size_t)(indent - 1) * 4, ' '); }
+        out += '}';
+    }
+};
+
+template<typename T>
+std::string config_to_json(const T &c){
+    std::string out;
+    JsonFieldWriter w{out, 0};
+    w.object(c);
+    out += '\n';
+    return out;
+}
+
+// ------------------------------- JSON read ------------------------------------------
+template<typename Json>
+struct JsonFieldReader {
+    const Json &obj;
+
+    void operator()(const char* name, bool &v){ if(const Json* j = find(name)) if(j->is_boolean()) v = j->template get<bool>(); }
+    void operator()(const char* name, float &v){ if(const Json* j = find(name)) if(j->is_number()) v = j->template get<float>(); }
+    void operator()(const char* name, std::string &v){ if(const Json* j = find(name)) if(j->is_string()) v = j->template get_ref<const std::string&>(); }
+    void operator()(const char* name, ImVec2 &v){ float xy[2] = { v.x, v.y }; (*this)(name, xy); v.x = xy[0]; v.y = xy[1]; }
+    template<size_t N> void operator()(const char* name, float (&v)[N]){
+        const Json* j = find(name);
+        if(!j || !j->is_array()) return;
+        for(size_t i = 0; i < N && i < j->size(); i++){
+            const Json &e = (*j)[i];
+            if(e.is_number()) v[i] = e.template get<float>();
+        }
+    }
+    template<typename E> void operator()(const char* name, E &v, const char* const* names, int count){
+        const Json* j = find(name);
+        if(!j || !j->is_string()) return;
+        const std::string &s = j->template get_ref<const std::string&>();
+        for(int i = 0; i < count; i++) if(s == names[i]){ v = (E)i; return; }
+    }
+    template<typename T> void operator()(const char* name, std::map<std::string, T> &m){
+        const Json* j = find(name);
+        if(!j || !j->is_object()) return;
+        for(auto it = j->begin(); it != j->end(); ++it){
+            if(!it->is_object()) continue;
+            T item;
+            JsonFieldReader<Json> r{*it};
+            ConfigSchema<T>::fields(item, r);
+            m[it.key()] = std::move(item);
+        }
+    }
+    template<typename T> void operator()(const char* name, T &v){
+        const Json* j = find(name);
+        if(!j || !j->is_object()) return;
+        JsonFieldReader<Json> r{*j};
+        ConfigSchema<T>::fields(v, r);
+    }
+
+private:
+    const Json* find(const char* name) const {
+        auto it = obj.find(name);
+        return it != obj.end() ? &*it : nullptr;
+    }
+};
+
+// `j` must be an object; fields it doesn't have keep their value in `out`.
+template<typename Json, typename T>
+void read_config_json(const Json &j, T &out){
+    JsonFieldReader<Json> r{j};
+    ConfigSchema<T>::fields(out, r);
+}
+
+// ------------------------------- Binary -------------------------------------------
+struct ConfigBinaryHeader {
+    char magic[4];        // "RCFG"
+    uint32_t version;
+    uint64_t schemaHash;  // config_schema_hash<T>() of the type written
+    uint64_t sourceStamp; // caller-defined, e.g. which JSON file this is a cache of (0 = none)
+};
+static_assert(sizeof(ConfigBinaryHeader) == 24, "ConfigBinaryHeader is 24 bytes on disk");
+
+static const char CONFIG_BINARY_MAGIC[4] = { 'R', 'C', 'F', 'G' };
+static constexpr uint32_t CONFIG_BINARY_VERSION = 1;
+
+struct BinaryFieldWriter {
+    std::string &out;
+
+    void operator()(const char*, const bool &v){ uint8_t b = v ? 1 : 0; bytes(&b, 1); }
+    void operator()(const char*, const float &v){ bytes(&v, sizeof(v)); }
+    void operator()(const char*, const std::string &v){ string(v); }
+    void operator()(const char*, const ImVec2 &v){ bytes(&v.x, sizeof(float)); bytes(&v.y, sizeof(float)); }
+    template<size_t N> void operator()(const char*, const float (&v)[N]){ bytes(v, sizeof(v)); }
+    template<typename E> void operator()(const char*, const E &v, const char* const*, int){ uint8_t b = (uint8_t)v; bytes(&b, 1); }
+    template<typename T> void operator()(const char*, const std::map<std::string, T> &m){
+        uint32_t n = (uint32_t)m.size(); bytes(&n, sizeof(n));
+        for(const auto &kv : m){ string(kv.first); ConfigSchema<T>::fields(kv.second, *this); }
+    }
+    template<typename T> void operator()(const char*, const T &v){ ConfigSchema<T>::fields(v, *this); }
+
+private:
+    void bytes(const void* p, size_t n){ out.append((const char*)p, n); }
+    void string(const std::string &s){
+        uint16_t n = (uint16_t)(s.size() > 0xffff ? 0xffff : s.size());
+        bytes(&n, sizeof(n)); bytes(s.data(), n);
+    }
+};
+
+// Stops at the first short read or out-of-range value (ok = false).
+struct BinaryFieldReader {
+    const unsigned char* p;
+    const unsigned char* end;
+    bool ok = true;
+
+    void operator()(const char*, bool &v){ uint8_t b; if(take(&b, 1)) v = b != 0; }
+    void operator()(const char*, float &v){ take(&v, sizeof(v)); }
+    void operator()(const char*, std::string &v){ string(v); }
+    void operator()(const char*, ImVec2 &v){ take(&v.x, sizeof(float)); take(&v.y, sizeof(float)); }
+    template<size_t N> void operator()(const char*, float (&v)[N]){ take(v, sizeof(v)); }
+    template<typename E> void operator()(const char*, E &v, const char* const*, int count){
+        uint8_t b;
+        if(!take(&b, 1)) return;
+        if(b < count) v = (E)b; else ok = false;
+    }
+    template<typename T> void operator()(const char*, std::map<std::string, T> &m){
+        uint32_t n;
+        if(!take(&n, sizeof(n))) return;
+        m.clear();
+        for(uint32_t i = 0; i < n && ok; i++){
+            std::string key; T item;
+            string(key);
+            ConfigSchema<T>::fields(item, *this);
+            if(ok) m.emplace_hint(m.end(), std::move(key), std::move(item)); // written in key order
+        }
+    }
+    template<typename T> void operator()(const char*, T &v){ ConfigSchema<T>::fields(v, *this); }
+
+private:
+    bool take(void* dst, size_t n){
+        if(!ok || (size_t)(end - p) < n){ ok = false; return false; }
+        memcpy(dst, p, n); p += n;
+        return true;
+    }
+    void string(std::string &s){
+        uint16_t n;
+        if(!take(&n, sizeof(n))) return;
+        if((size_t)(end - p) < n){ ok = false; return; }
+        s.assign((const char*)p, n); p += n;
+    }
+};
+
+// FNV-1a over every field's name and type, in order.
+struct SchemaHasher {
+    uint64_t h = 1469598103934665603ull;
+
+    void operator()(const char* name, const bool&){ field(name, "bool"); }
+    void operator()(const char* name, const float&){ field(name, "f32"); }
+    void operator()(const char* name, const std::string&){ field(name, "str"); }
+    void operator()(const char* name, const ImVec2&){ field(name, "vec2"); }
+    template<size_t N> void operator()(const char* name, const float (&)[N]){ size_t n = N; field(name, "f32["); mix((const char*)&n, sizeof(n)); }
+    template<typename E> void operator()(const char* name, const E&, const char* const*, int){ field(name, "enum8"); }
+    template<typename T> void operator()(const char* name, const std::map<std::string, T>&){
+        field(name, "map{"); T item; ConfigSchema<T>::fields(item, *this); mix("}", 1);
+    }
+    template<typename T> void operator()(const char* name, const T &v){ field(name, "{"); ConfigSchema<T>::fields(v, *this); mix("}", 1); }
+
+private:
+    void mix(const char* s, size_t n){ for(size_t i = 0; i < n; i++){ h ^= (unsigned char)s[i]; h *= 1099511628211ull; } }
+    void field(const char* name, const char* type){ mix(name, strlen(name) + 1); mix(type, strlen(type) + 1); }
+};
+
+template<typename T>
+uint64_t config_schema_hash(){
+    T dummy; SchemaHasher h;
+    h("", dummy);
+    return h.h;
+}
+
+template<typename T>
+std::string config_to_binary(const T &c, uint64_t sourceStamp = 0){
+    ConfigBinaryHeader hdr;
+    memcpy(hdr.magic, CONFIG_BINARY_MAGIC, 4); hdr.version = CONFIG_BINARY_VERSION;
+    hdr.schemaHash = config_schema_hash<T>(); hdr.sourceStamp = sourceStamp;
+    std::string out((const char*)&hdr, sizeof(hdr));
+    BinaryFieldWriter w{out};
+    w("", c);
+    return out;
+}
+
+// False (leaving `out` untouched) unless `data` is a complete binary of this schema.
+template<typename T>
+bool config_from_binary(const std::string &data, T &out, uint64_t* sourceStamp = nullptr){
+    ConfigBinaryHeader hdr;
+    if(data.size() < sizeof(hdr)) return false;
+    memcpy(&hdr, data.data(), sizeof(hdr));
+    if(memcmp(hdr.magic, CONFIG_BINARY_MAGIC, 4) != 0 || hdr.version != CONFIG_BINARY_VERSION || hdr.schemaHash != config_schema_hash<T>()) return false;
+    const unsigned char* p = (const unsigned char*)data.data();
+    BinaryFieldReader r{p + sizeof(hdr), p + data.size()};
+    T value;
+    r("", value);
+    if(!r.ok || r.p != r.end) return false;
+    out = std::move(value);
+    if(sourceStamp) *sourceStamp = hdr.sourceStamp;
+    return true;
+}
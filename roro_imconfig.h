@@ -0,0 +1,9 @@
+// roro_imconfig.h
+// Dear ImGui user config for Roro Client (pass -DIMGUI_USER_CONFIG="roro_imconfig.h").
+// The launcher and the overlay each drive their own ImGui context on their own thread, so the
+// current-context pointer must be thread-local instead of a single process-wide global.
+#pragma once
+
+struct ImGuiContext;
+extern thread_local ImGuiContext* RoroImGuiTLS;
+#define GImGui RoroImGuiTLS
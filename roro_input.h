@@ -0,0 +1,344 @@
+// roro_input.h
+// Roro Client - timestamped input capture for the overlay HUD
+// ---------------------------------------------------------------------------
+// A capture thread (owned by an InputSource) writes key/button edges into a fixed-size
+// single-producer/single-consumer ring; the overlay drains it once per frame. Edges are
+// stamped when they happen, not when a frame gets around to sampling them, so CPS and
+// keystroke panels stay exact at any overlay frame rate.
+// - Windows: low-level keyboard/mouse hooks (WH_KEYBOARD_LL / WH_MOUSE_LL).
+// - Linux:   evdev devices (/dev/input/eventN), stamped with CLOCK_MONOTONIC.
+// - Any:     SyntheticInputSource, for tests and replays.
+// All timestamps are std::chrono::steady_clock nanoseconds.
+// ---------------------------------------------------------------------------
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <dirent.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/input.h>
+#include <ctime>
+#endif
+
+// ------------------------------- Events ------------------------------------------
+enum InputCode : uint8_t {
+    INPUT_W, INPUT_A, INPUT_S, INPUT_D, INPUT_SPACE, INPUT_LBUTTON, INPUT_RBUTTON,
+    INPUT_CODE_COUNT
+};
+
+struct InputEvent {
+    uint64_t timeNs = 0; // steady_clock
+    uint8_t code = 0;    // InputCode
+    uint8_t down = 0;    // 1 = pressed, 0 = released
+};
+
+inline uint64_t input_now_ns(){
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+inline std::chrono::steady_clock::time_point input_time_point(uint64_t ns){
+    return std::chrono::steady_clock::time_point(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(ns)));
+}
+
+// ------------------------------- SPSC ring ---------------------------------------
+// Lock-free, fixed capacity (power of two). push() from exactly one thread, pop() from exactly
+// one other thread. A full ring drops the new event and counts it rather than blocking the hook.
+template<typename T, size_t N>
+class SpscRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing capacity must be a power of two");
+public:
+    bool push(const T &v){
+        size_t h = head_.load(std::memory_order_relaxed);
+        if(h - tail_.load(std::memory_order_acquire) == N){ dropped_.fetch_add(1, std::memory_order_relaxed); return false; }
+        buf_[h & (N - 1)] = v;
+        head_.store(h + 1, std::memory_order_release);
+        return true;
+    }
+    bool pop(T &out){
+        size_t t = tail_.load(std::memory_order_relaxed);
+        if(t == head_.load(std::memory_order_acquire)) return false;
+        out = buf_[t & (N - 1)];
+        tail_.store(t + 1, std::memory_order_release);
+        return true;
+    }
+    size_t size() const { return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire); }
+    uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    static constexpr size_t capacity(){ return N; }
+private:
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+    alignas(64) std::atomic<uint32_t> dropped_{0};
+    T buf_[N];
+};
+
+using InputRing = SpscRing<InputEvent, 1024>;
+
+// ------------------------------- Consumer-side state ------------------------------
+// Current held state, rebuilt from the drained edges. Kept by the overlay thread.
+struct InputState {
+    bool down[INPUT_CODE_COUNT] = {};
+    uint64_t lastEventNs = 0;
+
+    // Drain everything queued so far; onEvent(const InputEvent&) sees every edge in order.
+    template<typename F>
+    size_t drain(InputRing &ring, F &&onEvent){
+        size_t n = 0; InputEvent ev;
+        while(ring.pop(ev)){
+            if(ev.code < INPUT_CODE_COUNT) down[ev.code] = ev.down != 0;
+            lastEventNs = ev.timeNs;
+            onEvent(ev); n++;
+        }
+        return n;
+    }
+};
+
+// ------------------------------- Platform interface --------------------------------
+// start() begins producing into `ring` from the source's own thread; stop() joins it.
+// A source is the single producer of its ring.
+class InputSource {
+public:
+    virtual ~InputSource() {}
+    virtual bool start(InputRing &ring) = 0;
+    virtual void stop() = 0;
+    virtual const char* name() const = 0;
+};
+
+// Only emits true edges; OS auto-repeat for held keys is filtered out here. Sources reset it in
+// start(), so a key released while capture was stopped does not swallow its next press.
+struct EdgeFilter {
+    bool down[INPUT_CODE_COUNT] = {};
+    bool accept(uint8_t code, bool isDown){
+        if(code >= INPUT_CODE_COUNT || down[code] == isDown) return false;
+        down[code] = isDown; return true;
+    }
+};
+
+// Events are pushed by whoever calls inject(); that caller is the producer thread.
+class SyntheticInputSource : public InputSource {
+public:
+    bool start(InputRing &ring) override { ring_ = &ring; filter_ = EdgeFilter(); return true; }
+    void stop() override { ring_ = nullptr; }
+    const char* name() const override { return "synthetic"; }
+    bool inject(uint8_t code, bool isDown, uint64_t timeNs = 0){
+        if(!ring_ || !filter_.accept(code, isDown)) return false;
+        InputEvent ev; ev.timeNs = timeNs ? timeNs : input_now_ns(); ev.code = code; ev.down = isDown ? 1 : 0;
+        return ring_->push(ev);
+    }
+private:
+    InputRing* ring_ = nullptr;
+    EdgeFilter filter_;
+};
+
+#ifdef _WIN32
+// ------------------------------- Win32: low-level hooks ----------------------------
+// LL hooks are delivered to the installing thread's message loop, so the source runs its own
+// thread that does nothing but pump messages and stamp edges.
+class Win32HookInputSource : public InputSource {
+public:
+    ~Win32HookInputSource() override { stop(); }
+    bool start(InputRing &ring) override {
+        if(thread_.joinable()) return true;
+        // keys released while the hooks were off were never seen: start from "nothing held"
+        filter_ = EdgeFilter();
+        ring_ = &ring; s_active = this;
+        std::atomic<int> ok{0};
+        thread_ = std::thread([this, &ok]{
+            threadId_ = GetCurrentThreadId();
+            HMODULE mod = GetModuleHandle(NULL);
+            kbHook_ = SetWindowsHookExA(WH_KEYBOARD_LL, &Win32HookInputSource::keyboardProc, mod, 0);
+            msHook_ = SetWindowsHookExA(WH_MOUSE_LL, &Win32HookInputSource::mouseProc, mod, 0);
+            ok = (kbHook_ && msHook_) ? 1 : -1;
+            MSG msg;
+            while(GetMessage(&msg, NULL, 0, 0) > 0){ TranslateMessage(&msg); DispatchMessage(&msg); }
+            if(kbHook_) UnhookWindowsHookEx(kbHook_);
+            if(msHook_) UnhookWindowsHookEx(msHook_);
+            kbHook_ = msHook_ = NULL;
+        });
+        while(ok.load() == 0) std::this_thread::yield();
+        if(ok.load() < 0){ stop(); return false; }
+        return true;
+    }
+    void stop() override {
+        if(!thread_.joinable()) return;
+        PostThreadMessage(threadId_, WM_QUIT, 0, 0);
+        thread_.join();
+        if(s_active == this) s_active = nullptr;
+    }
+    const char* name() const override { return "win32-ll-hook"; }
+private:
+    static int mapKey(DWORD vk){
+        switch(vk){
+            case 'W': return INPUT_W; case 'A': return INPUT_A; case 'S': return INPUT_S; case 'D': return INPUT_D;
+            case VK_SPACE: return INPUT_SPACE;
+        }
+        return -1;
+    }
+    void emit(int code, bool isDown){
+        if(code < 0 || !filter_.accept((uint8_t)code, isDown)) return;
+        InputEvent ev; ev.timeNs = input_now_ns(); ev.code = (uint8_t)code; ev.down = isDown ? 1 : 0;
+        ring_->push(ev);
+    }
+    static LRESULT CALLBACK keyboardProc(int nCode, WPARAM wParam, LPARAM lParam){
+        if(nCode == HC_ACTION && s_active){
+            const KBDLLHOOKSTRUCT* k = (const KBDLLHOOKSTRUCT*)lParam;
+            bool isDown = (wParam == WM_KEYDOWN || wParam == WM_SYSKEYDOWN);
+            s_active->emit(mapKey(k->vkCode), isDown);
+        }
+        return CallNextHookEx(NULL, nCode, wParam, lParam);
+    }
+    static LRESULT CALLBACK mouseProc(int nCode, WPARAM wParam, LPARAM lParam){
+        if(nCode == HC_ACTION && s_active){
+            switch(wParam){
+                case WM_LBUTTONDOWN: s_active->emit(INPUT_LBUTTON, true); break;
+                case WM_LBUTTONUP:   s_active->emit(INPUT_LBUTTON, false); break;
+                case WM_RBUTTONDOWN: s_active->emit(INPUT_RBUTTON, true); break;
+                case WM_RBUTTONUP:   s_active->emit(INPUT_RBUTTON, false); break;
+            }
+        }
+        return CallNextHookEx(NULL, nCode, wParam, lParam);
+    }
+
+    static inline Win32HookInputSource* s_active = nullptr;
+    InputRing* ring_ = nullptr;
+    EdgeFilter filter_;
+    std::thread thread_;
+    DWORD threadId_ = 0;
+    HHOOK kbHook_ = NULL, msHook_ = NULL;
+};
+#endif
+
+#ifdef __linux__
+// ------------------------------- Linux: evdev --------------------------------------
+// Reads /dev/input/eventN devices (needs read permission, usually the `input` group). Keyboard
+// and mouse are separate devices, so every one that reports a mapped key or button is opened
+// and one thread polls them all. The kernel stamps events itself; switching each device to
+// CLOCK_MONOTONIC makes those stamps directly comparable with steady_clock. A device that
+// refuses the switch would stamp CLOCK_REALTIME, so its events are stamped when read instead.
+class EvdevInputSource : public InputSource {
+public:
+    // No devices: every /dev/input/eventN that reports one of the mapped keys or buttons.
+    explicit EvdevInputSource(std::vector<std::string> devices = std::vector<std::string>()) : devices_(std::move(devices)) {}
+    ~EvdevInputSource() override { stop(); }
+    bool start(InputRing &ring) override {
+        if(thread_.joinable()) return true;
+        bool scan = devices_.empty();
+        for(const std::string &path : scan ? list_devices() : devices_){
+            int fd = open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+            if(fd < 0) continue;
+            if(scan && !reports_mapped_codes(fd)){ close(fd); continue; }
+            int clk = CLOCK_MONOTONIC;
+            bool kernelStamps = ioctl(fd, EVIOCSCLOCKID, &clk) == 0;
+            if(!kernelStamps) fprintf(stderr, "evdev: %s cannot stamp with CLOCK_MONOTONIC; stamping its events when read\n", path.c_str());
+            fds_.push_back(pollfd{fd, POLLIN, 0});
+            kernelStamps_.push_back(kernelStamps);
+        }
+        if(fds_.empty()) return false;
+        filter_ = EdgeFilter(); // nothing held: releases while stopped were never seen
+        ring_ = &ring; running_ = true;
+        thread_ = std::thread([this]{ run(); });
+        return true;
+    }
+    void stop() override {
+        running_ = false;
+        if(thread_.joinable()) thread_.join();
+        for(pollfd &p : fds_) if(p.fd >= 0) close(p.fd);
+        fds_.clear(); kernelStamps_.clear();
+    }
+    const char* name() const override { return "evdev"; }
+    size_t devices() const { return fds_.size(); }
+
+private:
+    static int mapCode(unsigned type, unsigned code){
+        if(type != EV_KEY) return -1;
+        switch(code){
+            case KEY_W: return INPUT_W; case KEY_A: return INPUT_A; case KEY_S: return INPUT_S; case KEY_D: return INPUT_D;
+            case KEY_SPACE: return INPUT_SPACE; case BTN_LEFT: return INPUT_LBUTTON; case BTN_RIGHT: return INPUT_RBUTTON;
+        }
+        return -1;
+    }
+    static std::vector<std::string> list_devices(){
+        std::vector<std::string> out;
+        if(DIR* d = opendir("/dev/input")){
+            while(dirent* e = readdir(d)) if(strncmp(e->d_name, "event", 5) == 0) out.push_back(std::string("/dev/input/") + e->d_name);
+            closedir(d);
+        }
+        return out;
+    }
+    static bool reports_mapped_codes(int fd){
+        unsigned char bits[KEY_MAX / 8 + 1] = {};
+        if(ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(bits)), bits) < 0) return false;
+        static const unsigned codes[] = { KEY_W, KEY_A, KEY_S, KEY_D, KEY_SPACE, BTN_LEFT, BTN_RIGHT };
+        for(unsigned c : codes) if(bits[c / 8] & (1u << (c % 8))) return true;
+        return false;
+    }
+    void run(){
+        struct input_event evs[64];
+        while(running_.load(std::memory_order_relaxed)){
+            if(poll(fds_.data(), (nfds_t)fds_.size(), 50) <= 0) continue; // timeout doubles as the stop() check interval
+            for(size_t d = 0; d < fds_.size(); d++){
+                pollfd &p = fds_[d];
+                if(p.revents & (POLLERR | POLLHUP | POLLNVAL)){ close(p.fd); p.fd = -1; continue; } // unplugged: poll skips fd -1
+                if(!(p.revents & POLLIN)) continue;
+                ssize_t n = read(p.fd, evs, sizeof(evs));
+                uint64_t readNs = kernelStamps_[d] ? 0 : input_now_ns();
+                for(size_t i = 0; n > 0 && i < (size_t)n / sizeof(evs[0]); i++){
+                    int code = mapCode(evs[i].type, evs[i].code);
+                    if(code < 0 || evs[i].value == 2) continue; // 2 = auto-repeat
+                    bool isDown = evs[i].value != 0;
+                    if(!filter_.accept((uint8_t)code, isDown)) continue;
+                    InputEvent ev;
+                    ev.timeNs = readNs ? readNs : (uint64_t)evs[i].input_event_sec * 1000000000ull + (uint64_t)evs[i].input_event_usec * 1000ull;
+                    ev.code = (uint8_t)code; ev.down = isDown ? 1 : 0;
+                    ring_->push(ev);
+                }
+            }
+        }
+    }
+    std::vector<std::string> devices_;
+    std::vector<pollfd> fds_;
+    std::vector<bool> kernelStamps_; // per fds_ entry: CLOCK_MONOTONIC stamps from the kernel
+    InputRing* ring_ = nullptr;
+    EdgeFilter filter_;
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+};
+#endif
+
+// Default capture source for this platform (nullptr if there is none).
+// On Linux, $RORO_INPUT_DEVICE can name the devices to read (comma-separated, e.g.
+// /dev/input/event3,/dev/input/event5); otherwise every keyboard/mouse device is used.
+inline std::unique_ptr<InputSource> make_platform_input_source(){
+#ifdef _WIN32
+    return std::unique_ptr<InputSource>(new Win32HookInputSource());
+#elif defined(__linux__)
+    std::vector<std::string> devices;
+    if(const char* env = getenv("RORO_INPUT_DEVICE")){
+        std::string list = env;
+        for(size_t b = 0, e; b < list.size(); b = e + 1){
+            e = list.find(',', b); if(e == std::string::npos) e = list.size();
+            if(e > b) devices.push_back(list.substr(b, e - b));
+        }
+    }
+    return std::unique_ptr<InputSource>(new EvdevInputSource(devices));
+#else
+    return nullptr;
+#endif
+}
@@ -0,0 +1,130 @@
+// roro_latency.h
+// Roro Client - input-to-photon latency for the overlay HUD
+// ---------------------------------------------------------------------------
+// Every input edge carries the time it happened (roro_input.h). The overlay hands each edge it
+// drains to a LatencyTracker; when a frame is presented, every edge still pending is linked to
+// that frame (the first one to show it) and to the time its buffer swap returned. Latency is
+// that swap-complete time minus the edge time. It lands in a fixed histogram (0.1 ms buckets up
+// to 100 ms) for min/median/p99, and in a sample ring for export.
+// A frame skipped by render-on-change showed nothing new, so its edges never reach the screen as
+// such: they are dropped (counted as unshown) rather than charged to some later, unrelated frame.
+// Everything runs on the overlay thread and never allocates.
+// ---------------------------------------------------------------------------
+#pragma once
+
+#include "roro_input.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+struct LatencySample {
+    uint64_t inputNs = 0;    // when the edge happened
+    uint64_t presentNs = 0;  // swap completed for the first frame showing it
+    uint32_t frame = 0;      // presented-frame number
+    uint8_t code = 0, down = 0;
+};
+
+struct LatencyStats {
+    uint64_t count = 0;
+    float minMs = 0, p50Ms = 0, p99Ms = 0, maxMs = 0;
+};
+
+class LatencyTracker {
+public:
+    static constexpr uint32_t PENDING = 256;    // edges waiting for a presented frame
+    static constexpr uint32_t CAPACITY = 4096;  // retained samples for export
+    static constexpr uint32_t BUCKETS = 1000;   // 0.1 ms each; the last one also takes overflow
+    static constexpr uint64_t BUCKET_NS = 100000;
+
+    // An edge that this frame's HUD state includes.
+    void input(const InputEvent &ev){
+        if(ev.timeNs < sinceNs_) return; // captured before the overlay (re)started showing
+        if(pendingCount_ < PENDING) pending_[pendingCount_++] = ev;
+        else dropped_++;
+    }
+
+    // The frame that took in the pending edges finished presenting at `presentNs`.
+    void presented(uint32_t frame, uint64_t presentNs){
+        for(uint32_t i = 0; i < pendingCount_; i++){
+            const InputEvent &ev = pending_[i];
+            uint64_t ns = presentNs > ev.timeNs ? presentNs - ev.timeNs : 0;
+            uint64_t b = ns / BUCKET_NS; if(b >= BUCKETS) b = BUCKETS - 1;
+            hist_[b]++; count_++;
+            if(ns < minNs_) minNs_ = ns;
+            if(ns > maxNs_) maxNs_ = ns;
+            LatencySample &s = ring_[written_ % CAPACITY];
+            s.inputNs = ev.timeNs; s.presentNs = presentNs; s.frame = frame; s.code = ev.code; s.down = ev.down;
+            written_++;
+        }
+        pendingCount_ = 0;
+    }
+
+    // The frame that took in the pending edges was skipped (no panel changed): they are never
+    // shown by a frame of their own, so no latency is sampled for them.
+    void skipped(){ unshown_ += pendingCount_; pendingCount_ = 0; }
+
+    // Forget pending edges and ignore anything older than `nowNs` (overlay shown again after idling).
+    void restart(uint64_t nowNs){ pendingCount_ = 0; sinceNs_ = nowNs; }
+
+    // Clear the histogram and samples.
+    void reset(){
+        for(uint32_t i = 0; i < BUCKETS; i++) hist_[i] = 0;
+        count_ = 0; written_ = 0; dropped_ = 0; unshown_ = 0; minNs_ = ~0ull; maxNs_ = 0;
+    }
+
+    // Median and p99 are bucket upper bounds (0.1 ms resolution); min and max are exact.
+    LatencyStats stats() const {
+        LatencyStats s;
+        if(!count_) return s;
+        s.count = count_; s.minMs = minNs_ / 1e6f; s.maxMs = maxNs_ / 1e6f;
+        s.p50Ms = percentile(0.50); s.p99Ms = percentile(0.99);
+        return s;
+    }
+
+    uint64_t dropped() const { return dropped_; }
+    uint64_t unshown() const { return unshown_; } // edges whose frame was skipped
+    uint32_t size() const { return written_ < CAPACITY ? (uint32_t)written_ : CAPACITY; }
+    // i = 0 is the oldest retained sample.
+    const LatencySample& at(uint32_t i) const { return ring_[(written_ - size() + i) % CAPACITY]; }
+    uint64_t bucket(uint32_t i) const { return hist_[i]; }
+
+    // Copy of the retained samples, oldest first (for writing off the overlay thread).
+    std::vector<LatencySample> snapshot() const {
+        std::vector<LatencySample> out(size());
+        for(uint32_t i = 0; i < out.size(); i++) out[i] = at(i);
+        return out;
+    }
+
+private:
+    float percentile(double q) const {
+        uint64_t target = (uint64_t)(q * (count_ - 1)) + 1, seen = 0;
+        for(uint32_t i = 0; i < BUCKETS; i++){
+            seen += hist_[i];
+            if(seen >= target) return (i + 1) * BUCKET_NS / 1e6f;
+        }
+        return BUCKETS * BUCKET_NS / 1e6f;
+    }
+
+    InputEvent pending_[PENDING];
+    uint32_t pendingCount_ = 0;
+    uint64_t sinceNs_ = 0;
+    uint64_t hist_[BUCKETS] = {};
+    uint64_t count_ = 0, dropped_ = 0, unshown_ = 0, written_ = 0;
+    uint64_t minNs_ = ~0ull, maxNs_ = 0;
+    LatencySample ring_[CAPACITY];
+};
+
+// ------------------------------- Export -------------------------------------------
+// One row per sample: input time (us, relative to the first sample), latency, frame, input code.
+inline bool write_latency_csv(const std::vector<LatencySample> &samples, const LatencyStats &stats, const char* path){
+    FILE* f = fopen(path, "w");
+    if(!f) return false;
+    fprintf(f, "# count %llu  min %.2f ms  p50 %.2f ms  p99 %.2f ms  max %.2f ms\n",
+        (unsigned long long)stats.count, stats.minMs, stats.p50Ms, stats.p99Ms, stats.maxMs);
+    fprintf(f, "input_us,latency_us,frame,code,down\n");
+    uint64_t base = samples.empty() ? 0 : samples[0].inputNs;
+    for(const LatencySample &s : samples)
+        fprintf(f, "%.3f,%.3f,%u,%u,%u\n", (s.inputNs - base) / 1e3, (s.presentNs - s.inputNs) / 1e3, s.frame, s.code, s.down);
+    return fclose(f) == 0;
+}
@@ -31,25 +31,38 @@
 // BUILD (example with MSYS2/MinGW or Visual Studio)
 // - Place this file with: glad.c, imgui sources, stb_image.h, nlohmann json header.
 // - Example (MSYS2 / g++ with OpenGL and GLFW installed):
-//   g++ roro_launcher_overlay.cpp glad.c imgui/*.cpp imgui/backends/imgui_impl_glfw.cpp imgui/backends/imgui_impl_opengl3.cpp -I. -Iimgui -lglfw -lgdi32 -lopengl32 -o roro_launcher_overlay.exe
+//   g++ roro_launcher_overlay.cpp glad.c imgui/*.cpp imgui/backends/imgui_impl_glfw.cpp imgui/backends/imgui_impl_opengl3.cpp -I. -Iimgui -DIMGUI_USER_CONFIG=\"roro_imconfig.h\" -lglfw -lgdi32 -lopengl32 -o roro_launcher_overlay.exe
 // - For Visual Studio, create a project, add this file and required sources, link against opengl32.lib and glfw3.lib.
+// - IMGUI_USER_CONFIG must point at roro_imconfig.h for every ImGui source: the launcher and the
+//   overlay each run their own ImGui context on their own thread.
 // ---------------------------------------------------------------------------
 // USAGE
 // - Run roro_launcher_overlay.exe
 // - In Settings, set the path to your Minecraft Bedrock executable and save config
 // - Click Launch to start Minecraft. If Discord RPC is enabled and configured, the
 //   launcher will update your Discord presence while the launcher runs.
-// - Start the Overlay (from the launcher Settings) to show HUD while in-game.
+// - Start the Overlay (from the launcher Settings) to show HUD while in-game. By default it only
+//   runs while a game started from the launcher is running, and idles (hidden, no rendering, no
+//   input hooks) otherwise.
+// - Run with --startup-trace to print init phase timings (and write roro_startup.trace.json) on exit.
+// - Run with --record to record the session's input and overlay frames to roro_session.rrec
+//   (also a Settings toggle); --replay <file> replays a recording headless, prints the result
+//   and exits without opening any window.
+// - With "Export metrics" on, other programs can read the live HUD values from shared memory
+//   (roro_metrics.h; roro_metrics_cli prints them).
 // ---------------------------------------------------------------------------
 
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
 #include <shellapi.h>
 #include <shlwapi.h>
+#include <psapi.h>
 #pragma comment(lib, "Shlwapi.lib")
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#define GLFW_EXPOSE_NATIVE_WIN32
+#include <GLFW/glfw3native.h>
 
 #include "imgui.h"
 #include "backends/imgui_impl_glfw.h"
@@ -58,128 +71,289 @@
 #include <stb_image.h>
 #include <nlohmann/json.hpp>
 
+#define RORO_ALLOC_IMPLEMENTATION // this file owns the counting operator new/delete
+#include "roro_alloc.h"
+#include "roro_input.h"
+#include "roro_clickstats.h"
+#include "roro_config.h"
+#include "roro_panels.h"
+#include "roro_overlay.h"
+#include "roro_profiler.h"
+#include "roro_latency.h"
+#include "roro_metrics.h"
+#include "roro_record.h"
+#include "roro_pacing.h"
+#include "roro_persist.h"
+#include "roro_texture_cache.h"
+#include "roro_window_state.h"
+#include "roro_process.h"
+
 #include <string>
+#include <cstring>
 #include <fstream>
+#include <sstream>
 #include <iostream>
 #include <chrono>
-#include <deque>
 #include <map>
+#include <algorithm>
+#include <filesystem>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
 
 using json = nlohmann::json;
-using Clock = std::chrono::high_resolution_clock;
-
-// ------------------------------- Config structures ---------------------------------
-struct PanelConfig {
-    bool enabled = true;
-    bool background = true;
-    float scale = 1.0f;
-    float color[4] = {1.0f, 1.0f, 1.0f, 1.0f}; // rgba
-    float bgColor[4] = {0.0f,0.0f,0.0f,0.5f};
-    bool movable = true;
-    ImVec2 pos = ImVec2(100,100);
-};
-
-struct AppConfig {
-    std::string minecraftPath = ""; // path to bedrock exe
-    bool overlayClickThrough = false; // if true, overlay won't receive mouse input
-    bool overlayAlwaysOnTop = true;
-    std::map<std::string, PanelConfig> panels;
-};
+using Clock = std::chrono::steady_clock; // same clock the input capture thread stamps with
 
-static AppConfig g_config;
+// ------------------------------- Config ------------------------------------------
+// AppConfig, its schema and the built-in panel backfill live in roro_config.h
+static AppConfig g_config; // owned by the launcher (main) thread
 static const char* CONFIG_FILE = "roro_config.json";
+static const char* CONFIG_CACHE_FILE = "roro_config.bin"; // binary copy of the parsed JSON
+static const char* PROFILE_DIR = "roro_profiles";        // saved HUD layouts, <name>.rprof
 
-// defaults for panels
-static const char* PANEL_NAMES[] = {
-    "FPS COUNTER","CPS COUNTER","KEYSTROKE","REACH COUNTER","WATERMARK",
-    "MOOVABLE CHAT","MOOVABLE UI","MOOVABLE SCOREBOARD","FAST INVENTORY","JAVA INVENTORY",
-    "ESP","WHEATHER CHANGER","TIME CHANGER","FOV","NAMETAGS","HIDE_PSEUDO","TWERK","JAVA_MOVEMENTS"
-};
+// ------------------------------- Utility: config load/save -------------------------
+// Parse a roro_config.json document into `c`. Returns false (leaving `c` untouched) on bad JSON.
+// Missing or mistyped fields take their defaults.
+bool parse_config(const std::string &text, AppConfig &c){
+    try{
+        json j = json::parse(text);
+        if(!j.is_object()) return false;
+        AppConfig out;
+        read_config_json(j, out);
+        c = std::move(out);
+        return true;
+    } catch(...){ return false; }
+}
+
+std::string serialize_config(const AppConfig &c){ return config_to_json(c); }
+
+static bool read_file(const char* path, std::string &out){
+    std::ifstream in(path, std::ios::binary);
+    if(!in) return false;
+    std::stringstream ss; ss << in.rdbuf();
+    out = ss.str();
+    return true;
+}
+
+// Identifies one version of roro_config.json (size and modification time); 0 if it is missing.
+static uint64_t config_file_stamp(){
+    std::error_code ec;
+    auto t = std::filesystem::last_write_time(CONFIG_FILE, ec);
+    if(ec) return 0;
+    uintmax_t size = std::filesystem::file_size(CONFIG_FILE, ec);
+    if(ec) return 0;
+    return ((uint64_t)t.time_since_epoch().count() * 1000003ull) ^ (uint64_t)size;
+}
+
+// The JSON stays the file people edit. roro_config.bin is rewritten next to it after every save
+// and is used instead of parsing while its stamp still matches the JSON file.
+static void write_config_cache(const AppConfig &c){
+    write_file_atomic(CONFIG_CACHE_FILE, config_to_binary(c, config_file_stamp()));
+}
 
-// ------------------------------- Utility: JSON load/save ---------------------------
 void load_config(){
     std::ifstream in(CONFIG_FILE);
-    if(!in) {
-        // create defaults
-        for(auto &name : PANEL_NAMES){
-            PanelConfig p; p.enabled = true; p.background = true; p.scale = 1.0f; p.movable = true;
-            g_config.panels[name] = p;
-        }
-        return;
+    if(!in){ add_builtin_panels(g_config); return; } // defaults
+    std::string text;
+    if(!read_file(CONFIG_CACHE_FILE, text) || !read_config_cache(text, config_file_stamp(), g_config)){
+        std::stringstream ss; ss << in.rdbuf();
+        if(parse_config(ss.str(), g_config)) write_config_cache(g_config);
+        else std::cerr<<"Failed to parse config.json\n";
     }
-    try{
-        json j; in >> j;
-        g_config.minecraftPath = j.value("minecraftPath", "");
-        g_config.overlayClickThrough = j.value("overlayClickThrough", false);
-        g_config.overlayAlwaysOnTop = j.value("overlayAlwaysOnTop", true);
-        if(j.contains("panels")){
-            for(auto &it : j["panels"].items()){
-                PanelConfig p;
-                auto obj = it.value();
-                p.enabled = obj.value("enabled", true);
-                p.background = obj.value("background", true);
-                p.scale = obj.value("scale", 1.0f);
-                if(obj.contains("color")){
-                    auto a = obj["color"];
-                    for(int i=0;i<4;i++) p.color[i] = a.value(i, p.color[i]);
-                }
-                if(obj.contains("bgColor")){
-                    auto a = obj["bgColor"];
-                    for(int i=0;i<4;i++) p.bgColor[i] = a.value(i, p.bgColor[i]);
-                }
-                if(obj.contains("pos")){
-                    auto a = obj["pos"];
-                    p.pos.x = a.value(0, p.pos.x); p.pos.y = a.value(1, p.pos.y);
-                }
-                p.movable = obj.value("movable", true);
-                g_config.panels[it.key()] = p;
-            }
-        }
-    } catch(...){ std::cerr<<"Failed to parse config.json\n"; }
+    add_builtin_panels(g_config);
+}
+
+// Saving never touches the disk on the calling thread: the persister serializes and writes
+// (temp file + rename) from its worker once edits stop arriving for a moment. It also watches
+// the file and queues external edits for hot reload (see poll_config_reload).
+static ConfigPersister<AppConfig> g_persist(CONFIG_FILE, serialize_config, parse_config);
+
+void save_config(bool immediate = false){ g_persist.submit(g_config, immediate); }
+
+// ------------------------------- HUD profiles ---------------------------------------
+// A profile is the panels map alone, in the binary config format: switching layouts reads one
+// small file and never touches JSON.
+static bool valid_profile_name(const std::string &name){
+    return !name.empty() && name != "." && name != ".." && name.find_first_of("/\\:*?\"<>|") == std::string::npos;
 }
 
-void save_config(){
-    json j;
-    j["minecraftPath"] = g_config.minecraftPath;
-    j["overlayClickThrough"] = g_config.overlayClickThrough;
-    j["overlayAlwaysOnTop"] = g_config.overlayAlwaysOnTop;
-    json panels;
-    for(auto &kv : g_config.panels){
-        json p;
-        p["enabled"] = kv.second.enabled;
-        p["background"] = kv.second.background;
-        p["scale"] = kv.second.scale;
-        p["movable"] = kv.second.movable;
-        p["color"] = { kv.second.color[0], kv.second.color[1], kv.second.color[2], kv.second.color[3] };
-        p["bgColor"] = { kv.second.bgColor[0], kv.second.bgColor[1], kv.second.bgColor[2], kv.second.bgColor[3] };
-        p["pos"] = { kv.second.pos.x, kv.second.pos.y };
-        panels[kv.first] = p;
+static std::vector<std::string> list_hud_profiles(){
+    std::vector<std::string> names;
+    std::error_code ec;
+    for(std::filesystem::directory_iterator it(PROFILE_DIR, ec), end; !ec && it != end; it.increment(ec))
+        if(it->path().extension() == ".rprof") names.push_back(it->path().stem().string());
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+static bool save_hud_profile(const std::string &name){
+    if(!valid_profile_name(name)) return false;
+    std::error_code ec;
+    std::filesystem::create_directories(PROFILE_DIR, ec);
+    return write_file_atomic(std::string(PROFILE_DIR) + "/" + name + ".rprof", config_to_binary(g_config.panels));
+}
+
+// Replaces g_config.panels; the caller publishes and saves.
+static bool load_hud_profile(const std::string &name){
+    std::string data;
+    if(!valid_profile_name(name) || !read_file((std::string(PROFILE_DIR) + "/" + name + ".rprof").c_str(), data)
+        || !config_from_binary(data, g_config.panels)) return false;
+    add_builtin_panels(g_config); // a profile saved before a panel existed
+    return true;
+}
+
+// ------------------------------- Launcher <-> overlay config exchange --------------
+// The launcher thread owns g_config and publishes a full copy whenever it edits it. The overlay
+// thread renders from its own copy, re-taken only when the version moves, and hands panel
+// positions it changed (drags) back through movedPanels for the launcher to merge.
+struct ConfigExchange {
+    std::mutex m;
+    AppConfig snapshot;
+    std::map<std::string, ImVec2> movedPanels;
+    std::atomic<uint64_t> version{0};
+};
+static ConfigExchange g_cfgx;
+
+void publish_config(){
+    std::lock_guard<std::mutex> lk(g_cfgx.m);
+    g_cfgx.snapshot = g_config;
+    g_cfgx.version.fetch_add(1, std::memory_order_release);
+}
+
+// Overlay side: refresh `local` if the launcher published since `seen`. Returns true on refresh.
+bool acquire_config(AppConfig &local, uint64_t &seen){
+    uint64_t v = g_cfgx.version.load(std::memory_order_acquire);
+    if(v == seen) return false;
+    std::lock_guard<std::mutex> lk(g_cfgx.m);
+    local = g_cfgx.snapshot;
+    seen = g_cfgx.version.load(std::memory_order_relaxed);
+    return true;
+}
+
+// Launcher side: pull positions the overlay moved into g_config (before saving or republishing).
+// Returns true if anything moved.
+bool merge_overlay_positions(){
+    std::lock_guard<std::mutex> lk(g_cfgx.m);
+    bool moved = !g_cfgx.movedPanels.empty();
+    for(auto &kv : g_cfgx.movedPanels){
+        auto it = g_config.panels.find(kv.first);
+        if(it != g_config.panels.end()){ it->second.pos = kv.second; g_cfgx.snapshot.panels[kv.first].pos = kv.second; }
     }
-    j["panels"] = panels;
-    std::ofstream out(CONFIG_FILE);
-    out << j.dump(4);
+    g_cfgx.movedPanels.clear();
+    return moved;
+}
+
+// Launcher side: apply an external edit of roro_config.json picked up by the persister.
+bool poll_config_reload(){
+    AppConfig reloaded;
+    if(!g_persist.takeReloaded(reloaded)) return false;
+    add_builtin_panels(reloaded);
+    g_config = std::move(reloaded);
+    publish_config();
+    return true;
 }
 
 // ------------------------------- Helper: launch Minecraft -------------------------
+// Started and watched on GameLauncher's worker; state changes wake the launcher loop, which
+// shows or idles the overlay to match.
+static GameLauncher g_game;
+static const char* BEDROCK_PROCESS_NAME = "Minecraft.Windows.exe"; // what a store activation ends up running
+
 bool launch_minecraft(const std::string &path){
     if(path.empty()) return false;
-    // Use ShellExecute to open if it's registered; otherwise CreateProcess
-    HINSTANCE h = ShellExecuteA(NULL, "open", path.c_str(), NULL, NULL, SW_SHOWNORMAL);
-    if((INT_PTR)h > 32) return true;
-    // fallback: try CreateProcess
-    STARTUPINFOA si; PROCESS_INFORMATION pi; ZeroMemory(&si, sizeof(si)); si.cb = sizeof(si); ZeroMemory(&pi, sizeof(pi));
-    BOOL ok = CreateProcessA(path.c_str(), NULL, NULL, NULL, FALSE, 0, NULL, NULL, &si, &pi);
-    if(ok){ CloseHandle(pi.hProcess); CloseHandle(pi.hThread); return true; }
-    return false;
+    // A store install (or a shell hand-off to a running instance) leaves no process handle:
+    // look for the game by the exe's own name, or Bedrock's, and watch that instead.
+    std::string exe = std::filesystem::path(path).filename().string();
+    bool isExe = exe.size() > 4 && _stricmp(exe.c_str() + exe.size() - 4, ".exe") == 0;
+    auto locate = [exe, isExe]{
+        long pid = isExe ? find_process_by_name(exe) : 0;
+        return pid ? pid : find_process_by_name(BEDROCK_PROCESS_NAME);
+    };
+    return g_game.launch(path, std::vector<std::string>(), [](ProcessState){ glfwPostEmptyEvent(); }, locate);
+}
+
+// Ask for the game executable; true if the user picked one.
+static bool choose_minecraft_path(){
+    char buffer[MAX_PATH] = {0};
+    OPENFILENAMEA ofn; ZeroMemory(&ofn, sizeof(ofn)); ofn.lStructSize = sizeof(ofn); ofn.hwndOwner = NULL; ofn.lpstrFile = buffer; ofn.nMaxFile = MAX_PATH; ofn.lpstrFilter = "Executables\0*.exe\0All\0*.*\0";
+    ofn.Flags = OFN_FILEMUSTEXIST | OFN_PATHMUSTEXIST;
+    if(!GetOpenFileNameA(&ofn)) return false;
+    g_config.minecraftPath = std::string(buffer);
+    save_config(true);
+    return true;
 }
 
 // ------------------------------- Overlay utilities -------------------------------
-// For CPS tracking
-std::deque<Clock::time_point> clickTimes;
-int getCPS(){ auto now = Clock::now(); while(!clickTimes.empty() && std::chrono::duration_cast<std::chrono::milliseconds>(now - clickTimes.front()).count() > 1000) clickTimes.pop_front(); return (int)clickTimes.size(); }
+// For CPS tracking (fixed rings, no allocation per click)
+ClickStats g_clicks;
 
 // FPS tracking
 float g_fps = 0.0f;
+float g_skipRatio = 0.0f; // render-on-change: share of overlay loop iterations that skipped presenting
+
+// Init phase timestamps; printed and written to roro_startup.trace.json with --startup-trace.
+static StartupTrace g_startup;
+
+static double working_set_mb(){
+    PROCESS_MEMORY_COUNTERS pmc;
+    if(!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return 0.0;
+    return pmc.WorkingSetSize / (1024.0 * 1024.0);
+}
+
+// Frame profiler (overlay thread). Dumps go to roro_frames.csv / roro_frames.trace.json.
+static FrameProfiler g_profiler;
+static FrameStats g_frameStats;
+static std::atomic<bool> g_dumpProfile{false};
+
+// Input-to-present latency (overlay thread); dumped to roro_latency.csv with the frame profile.
+static LatencyTracker g_latency;
+static LatencyStats g_latencyStats;
+
+// Writes a copy of the profile from a worker thread so the overlay never waits on the disk.
+static void dump_frame_profile(){
+    std::vector<FrameRecord> frames = g_profiler.snapshot();
+    std::vector<LatencySample> latency = g_latency.snapshot();
+    LatencyStats latencyStats = g_latency.stats();
+    std::thread([frames, latency, latencyStats]{
+        if(!write_frames_csv(frames, "roro_frames.csv") || !write_frames_chrome_trace(frames, "roro_frames.trace.json")
+           || !write_latency_csv(latency, latencyStats, "roro_latency.csv"))
+            std::cerr<<"Failed to write frame profile\n";
+    }).detach();
+}
+
+// Input capture: the platform source's thread fills g_inputRing; the overlay thread drains it
+static InputRing g_inputRing;
+static InputState g_input;
+
+// Session recording (overlay thread); g_record is the wanted state (Settings, --record).
+static const char* RECORDING_PATH = "roro_session.rrec";
+static SessionRecorder g_recorder;
+static std::atomic<bool> g_record{false};
+
+// Shared-memory metrics for external readers (overlay thread; overlayMetricsExport)
+static MetricsPublisher g_metrics;
+
+static void publish_metrics(const HudState &hud, const InputState &input, uint64_t frame, uint64_t nowNs){
+    MetricsSnapshot m;
+    m.frame = frame; m.timeNs = nowNs;
+    for(int c = 0; c < INPUT_CODE_COUNT; c++) if(input.down[c]) m.keys |= 1u << c;
+    m.fps = hud.fps; m.reach = hud.reach;
+    for(int b = 0; b < CLICK_BUTTON_COUNT; b++){
+        ClickButton cb = (ClickButton)b;
+        m.cps[b] = hud.clicks->rate(cb, CLICK_WINDOW_1S); m.cps5s[b] = hud.clicks->rate(cb, CLICK_WINDOW_5S);
+        m.cpsAverage[b] = hud.clicks->average(cb); m.cpsPeak[b] = (uint32_t)hud.clicks->peak(cb); m.clicks[b] = hud.clicks->total(cb);
+    }
+    if(hud.profiler){
+        m.flags |= METRICS_FLAG_FRAME_STATS;
+        m.frameAvgMs = hud.frameStats.avgMs; m.frameP99Ms = hud.frameStats.p99Ms; m.onePercentLowFps = hud.frameStats.onePercentLowFps;
+    }
+    if(hud.latency.count){
+        m.flags |= METRICS_FLAG_LATENCY;
+        m.latencyP50Ms = hud.latency.p50Ms; m.latencyP99Ms = hud.latency.p99Ms;
+    }
+    g_metrics.publish(m);
+}
 
 // Keystroke tracking
 bool keyStateW=false, keyStateA=false, keyStateS=false, keyStateD=false, keyStateSpace=false;
@@ -187,26 +361,18 @@ bool keyStateW=false, keyStateA=false, keyStateS=false, keyStateD=false, keyStat
 // Reach measurement (naive local approximation: distance advanced along forward ray until click)
 float lastReach = 0.0f;
 
-// Load image as OpenGL texture (using stb_image)
-GLuint loadTextureFromFile(const char* filename, int &out_w, int &out_h){
-    int n; unsigned char* data = stbi_load(filename, &out_w, &out_h, &n, 4);
-    if(!data) return 0;
+// Upload a decoded RGBA image as an OpenGL texture (decoding happens in roro_texture_cache.h).
+// Images arrive already sized to the framebuffer, so no mipmaps are needed.
+GLuint uploadTexture(const DecodedImage &img){
+    if(img.rgba.empty()) return 0;
     GLuint tex; glGenTextures(1, &tex); glBindTexture(GL_TEXTURE_2D, tex);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, out_w, out_h, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-    stbi_image_free(data);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, img.w, img.h, 0, GL_RGBA, GL_UNSIGNED_BYTE, img.rgba.data());
     return tex;
 }
 
-// ------------------------------- Win32: make window click-through ----------------
-void setWindowClickThrough(HWND hwnd, bool clickThrough){
-    LONG ex = GetWindowLong(hwnd, GWL_EXSTYLE);
-    if(clickThrough) ex |= WS_EX_TRANSPARENT | WS_EX_LAYERED;
-    else ex &= ~(WS_EX_TRANSPARENT);
-    SetWindowLong(hwnd, GWL_EXSTYLE, ex);
-}
-
 // ------------------------------- ImGui helpers -----------------------------------
 static void PushStyleForPanel(const PanelConfig &p){
     ImGui::PushStyleVar(ImGuiStyleVar_WindowRounding, 6.0f);
@@ -215,13 +381,249 @@ static void PushStyleForPanel(const PanelConfig &p){
 }
 static void PopStyleForPanel(){ ImGui::PopStyleColor(); ImGui::PopStyleVar(2); }
 
+// GImGui is thread-local (see roro_imconfig.h) so the launcher and overlay contexts never collide.
+thread_local ImGuiContext* RoroImGuiTLS = nullptr;
+
+// ------------------------------- Overlay thread -------------------------------------
+// The overlay owns its GL context and ImGui context and is paced by its own swap interval,
+// independent of the launcher window (which may sit minimized while the user plays).
+static std::atomic<bool> g_showOverlay{true};    // user toggle in Settings
+static std::atomic<bool> g_overlayActive{false}; // shown, and (overlayFollowGame) the game is running
+static std::atomic<bool> g_quit{false};
+static std::mutex g_overlayWakeMutex;
+static std::condition_variable g_overlayWake;
+static std::atomic<int> g_overlayFbW{0}, g_overlayFbH{0};
+static std::atomic<int> g_overlayWinW{0}, g_overlayWinH{0}; // window size in screen coordinates (ImGui DisplaySize)
+static std::atomic<float> g_displayHz{0.0f}; // refresh rate of the overlay's monitor (main thread queries it)
+
+static void wake_overlay(){ std::lock_guard<std::mutex> lk(g_overlayWakeMutex); g_overlayWake.notify_all(); }
+
+static void overlay_thread_main(GLFWwindow* overlay){
+    glfwMakeContextCurrent(overlay);
+    // Frame pacing per cfg.overlayPacing; also picks the swap interval (set with the first config)
+    FrameScheduler scheduler;
+    PacingConfig pacing; bool pacingSet = false;
+    PacingStats pacingStats;
+
+    ImGui::CreateContext(); ImGui::StyleColorsDark();
+    ImGuiIO& io = ImGui::GetIO();
+    // No GLFW platform backend here: it queries and sets window, cursor and input state, which
+    // GLFW only allows on the main thread. Display size comes from the main thread's size
+    // callbacks, the pointer from Win32, buttons from the input ring. imgui.ini belongs to the
+    // launcher context; panel positions live in the config.
+    io.IniFilename = NULL;
+    io.ConfigFlags |= ImGuiConfigFlags_NoMouseCursorChange;
+    ImGui_ImplOpenGL3_Init("#version 330");
+    HWND overlayHwnd = glfwGetWin32Window(overlay); // safe from any thread
+    uint64_t lastImGuiNs = 0;
+
+    AppConfig cfg; uint64_t cfgVersion = ~0ull;
+    PanelRegistry registry;
+    std::vector<PanelInstance> panels; // enabled panels only, rebuilt per config snapshot
+    FpsCounter fpsCounter; // counts presented frames
+    // Topmost / click-through styles, only touched when the config asks for something different
+    Win32WindowBackend windowBackend(overlayHwnd);
+    WindowStateCache windowState(windowBackend);
+    WindowState wantWindow;
+    // render-on-change: frames still owed after a change (ImGui auto-resize settles a frame late)
+    int owedFrames = 0; int lastW = 0, lastH = 0;
+    uint64_t framesPresented = 0, framesSkipped = 0;
+    DrawStats lastDraw; lastDraw.drawCmds = -1;
+    POINT lastCursor = {0,0};
+    bool metricsFailed = false; // don't retry creating the shared memory every frame
+    uint64_t loopFrames = 0;
+
+    while(!g_quit.load()){
+        if(!g_overlayActive.load()){
+            // Capture is stopped before the overlay goes inactive. Count the clicks it left in the
+            // ring, then forget what is held: releases while the hooks are off are never seen.
+            g_input.drain(g_inputRing, [](const InputEvent &ev){ g_recorder.input(ev); count_click_edge(g_clicks, ev); });
+            g_input = InputState();
+            g_recorder.idle(input_now_ns());
+            io.AddMouseButtonEvent(0, false);
+            std::unique_lock<std::mutex> lk(g_overlayWakeMutex);
+            g_overlayWake.wait(lk, []{ return g_overlayActive.load() || g_quit.load(); });
+            uint64_t shownNs = input_now_ns();
+            fpsCounter.restart(shownNs); owedFrames = 2;
+            g_profiler.cancelFrame();
+            g_latency.restart(shownNs); // edges from while hidden were never on screen
+            g_recorder.resume(shownNs);
+            scheduler.resync();
+            continue;
+        }
+        uint64_t frameStartNs = scheduler.wait();
+        g_profiler.beginFrame();
+        frame_arena().reset();
+        if(acquire_config(cfg, cfgVersion)){ registry.build(cfg.panels, panels); owedFrames = 2; }
+        if(!pacingSet || cfg.overlayPacing.mode != pacing.mode || cfg.overlayPacing.targetHz != pacing.targetHz){
+            pacing = cfg.overlayPacing; pacingSet = true;
+            scheduler.configure(pacing, g_displayHz.load());
+            glfwSwapInterval(scheduler.swapInterval());
+        }
+        if(g_dumpProfile.exchange(false)) dump_frame_profile();
+        if(g_record.load() != g_recorder.active()){
+            if(g_recorder.active()) g_recorder.stop();
+            else if(!g_recorder.start(RECORDING_PATH, input_now_ns(), g_input)){ std::cerr<<"Failed to open "<<RECORDING_PATH<<"\n"; g_record = false; }
+        }
+        if(!cfg.overlayMetricsExport) metricsFailed = false; // switching it off and on again retries
+        if(cfg.overlayMetricsExport != g_metrics.active() && !metricsFailed){
+            if(g_metrics.active()) g_metrics.close();
+            else if(!g_metrics.open()){ std::cerr<<"Failed to create metrics shared memory "<<METRICS_SHM_NAME<<"\n"; metricsFailed = true; }
+        }
+
+        apply_overlay_window(windowState, wantWindow, cfg.overlayAlwaysOnTop, cfg.overlayClickThrough);
+        g_profiler.mark(STAGE_EVENTS);
+
+        // Drain input edges captured since the last frame. Clicks keep the time they happened, so
+        // none are lost or skewed however long this frame took. Left button also feeds ImGui,
+        // which has no GLFW callbacks on this thread.
+        // The CPS / keystroke / FPS bookkeeping here is what a replay (roro_record.h) re-runs.
+        g_input.drain(g_inputRing, [&](const InputEvent &ev){
+            g_latency.input(ev);
+            g_recorder.input(ev);
+            count_click_edge(g_clicks, ev);
+            if(ev.code == INPUT_LBUTTON && !cfg.overlayClickThrough) io.AddMouseButtonEvent(0, ev.down != 0);
+        });
+        uint64_t inputNs = input_now_ns();
+        g_clicks.update(inputNs);
+        g_recorder.frame(inputNs);
+        keyStateW = g_input.down[INPUT_W];
+        keyStateA = g_input.down[INPUT_A];
+        keyStateS = g_input.down[INPUT_S];
+        keyStateD = g_input.down[INPUT_D];
+        keyStateSpace = g_input.down[INPUT_SPACE];
+        g_profiler.mark(STAGE_INPUT);
+
+        // Update fps (every half second)
+        if(fpsCounter.update(inputNs)){ g_fps = fpsCounter.fps(); g_skipRatio = fpsCounter.skipRatio();
+            if(cfg.overlayFrameStats) g_frameStats = g_profiler.computeStats();
+            g_latencyStats = g_latency.stats(); pacingStats = scheduler.stats(); }
+
+        HudState hud;
+        hud.fps = g_fps; hud.clicks = &g_clicks; hud.reach = lastReach;
+        hud.keyW = keyStateW; hud.keyA = keyStateA; hud.keyS = keyStateS; hud.keyD = keyStateD; hud.keySpace = keyStateSpace;
+        hud.skipRatio = cfg.overlayRenderOnChange ? g_skipRatio : -1.0f;
+        hud.latency = g_latencyStats;
+        hud.pacing = pacingStats;
+        if(cfg.overlayFrameStats){ hud.profiler = &g_profiler; hud.frameStats = g_frameStats; hud.drawCalls = lastDraw.drawCmds; hud.drawVertices = lastDraw.vertices; }
+        // external readers get every iteration, including ones render-on-change skips below
+        if(g_metrics.active()) publish_metrics(hud, g_input, ++loopFrames, inputNs);
+
+        int ow = g_overlayFbW.load(), oh = g_overlayFbH.load();
+        uint64_t nowNs = input_now_ns();
+        if(cfg.overlayRenderOnChange){
+            // Present only if something on screen would differ: a panel value, the layout, the
+            // window size, or a drag in progress. Otherwise skip NewFrame/Render/swap entirely.
+            // When the overlay takes input, pointer motion counts too: hovering a batched panel is
+            // what turns it into a draggable window.
+            bool dragging = !cfg.overlayClickThrough && g_input.down[INPUT_LBUTTON];
+            bool pointerMoved = false;
+            if(!cfg.overlayClickThrough && cfg.overlayBatchedHud){
+                POINT pt; GetCursorPos(&pt);
+                pointerMoved = pt.x != lastCursor.x || pt.y != lastCursor.y; lastCursor = pt;
+            }
+            if(ow != lastW || oh != lastH || dragging || pointerMoved || panels_changed(panels, hud, nowNs)) owedFrames = 2;
+            if(owedFrames == 0){
+                fpsCounter.skipped(); framesSkipped++;
+                g_latency.skipped(); // this frame's edges changed nothing on screen
+                g_recorder.endFrame(false, input_now_ns() - frameStartNs);
+                g_profiler.cancelFrame();
+                scheduler.skipped();
+                if(!scheduler.paces()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                continue;
+            }
+            owedFrames--;
+        }
+        lastW = ow; lastH = oh;
+
+        glViewport(0,0,ow,oh);
+        glClearColor(0,0,0,0); // transparent background
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        // What ImGui_ImplGlfw_NewFrame would do, from thread-safe sources
+        int ww = g_overlayWinW.load(), wh = g_overlayWinH.load();
+        io.DisplaySize = ImVec2((float)ww, (float)wh);
+        if(ww > 0 && wh > 0) io.DisplayFramebufferScale = ImVec2((float)ow / ww, (float)oh / wh);
+        io.DeltaTime = lastImGuiNs && nowNs > lastImGuiNs ? (float)((nowNs - lastImGuiNs) / 1e9) : 1.0f / 60.0f;
+        lastImGuiNs = nowNs;
+        POINT cursor;
+        if(GetCursorPos(&cursor) && ScreenToClient(overlayHwnd, &cursor)) io.AddMousePosEvent((float)cursor.x, (float)cursor.y);
+        ImGui_ImplOpenGL3_NewFrame(); ImGui::NewFrame();
+        g_profiler.mark(STAGE_NEWFRAME);
+
+        // HUD rendering for each enabled panel (batched, or movable windows); hand drags back
+        // to the launcher
+        if(build_overlay_panels(panels, hud, cfg.overlayClickThrough, cfg.overlayBatchedHud)){
+            std::lock_guard<std::mutex> lk(g_cfgx.m);
+            for(const PanelInstance &pi : panels) if(pi.moved) g_cfgx.movedPanels[pi.name] = pi.cfg.pos;
+            glfwPostEmptyEvent(); // the launcher may be minimized and blocked in glfwWaitEvents
+        }
+        g_profiler.mark(STAGE_PANELS);
+
+        ImGui::Render(); ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        lastDraw = draw_stats(ImGui::GetDrawData());
+        g_profiler.mark(STAGE_RENDER);
+        glfwSwapBuffers(overlay);
+        g_latency.presented((uint32_t)framesPresented, input_now_ns()); // first frame to show this frame's edges
+        g_profiler.mark(STAGE_SWAP);
+        g_recorder.endFrame(true, input_now_ns() - frameStartNs);
+        if(cfg.overlayRenderOnChange) mark_panels_presented(panels, hud, nowNs);
+        fpsCounter.presented(); framesPresented++;
+        if(framesPresented == 1) g_startup.mark("overlay first frame");
+    }
+
+    if(framesPresented + framesSkipped)
+        std::cout<<"Overlay: "<<framesPresented<<" frames presented, "<<framesSkipped<<" skipped ("
+                 <<(100.0 * framesSkipped / (framesPresented + framesSkipped))<<"% skipped), "
+                 <<g_inputRing.dropped()<<" input edges dropped (ring full)\n";
+    std::cout<<"Overlay: "<<windowState.calls()<<" window style calls\n";
+    pacingStats = scheduler.stats();
+    if(pacingStats.frames)
+        std::cout<<"Overlay: pacing "<<PACING_MODE_NAMES[pacingStats.mode]<<", "<<pacingStats.missed<<" missed deadlines, jitter "
+                 <<pacingStats.jitterMs<<" ms (max late "<<pacingStats.maxLateMs<<" ms)\n";
+    LatencyStats lat = g_latency.stats();
+    if(lat.count)
+        std::cout<<"Overlay: input-to-present latency min "<<lat.minMs<<" ms, p50 "<<lat.p50Ms<<" ms, p99 "<<lat.p99Ms
+                 <<" ms over "<<lat.count<<" input edges ("<<g_latency.unshown()<<" changed nothing on screen)\n";
+    if(g_recorder.active()){
+        std::cout<<"Overlay: recorded "<<g_recorder.entries()<<" entries to "<<RECORDING_PATH<<"\n";
+        g_recorder.stop();
+    }
+    if(g_recorder.failed()) std::cerr<<"Failed to write "<<RECORDING_PATH<<"\n";
+    g_metrics.close();
+    if(framesPresented)
+        std::cout<<"Overlay: last frame "<<lastDraw.drawCmds<<" draw calls, "<<lastDraw.vertices<<" vertices ("
+                 <<lastDraw.drawLists<<" draw lists)\n";
+    ImGui_ImplOpenGL3_Shutdown(); ImGui::DestroyContext();
+    glfwMakeContextCurrent(NULL);
+}
+
 // ------------------------------- Main ------------------------------------------------
 int main(int argc, char** argv){
+    bool startupTrace = false;
+    for(int i = 1; i < argc; i++){
+        if(strcmp(argv[i], "--startup-trace") == 0) startupTrace = true;
+        else if(strcmp(argv[i], "--record") == 0) g_record = true;
+        else if(strcmp(argv[i], "--replay") == 0 && i + 1 < argc){
+            // headless: no config, no windows
+            Recording rec;
+            if(!read_recording(argv[i + 1], rec)){ std::cerr<<"Not a session recording: "<<argv[i + 1]<<"\n"; return 1; }
+            auto t0 = Clock::now();
+            ReplayStats stats = replay_recording(rec);
+            double ms = std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(Clock::now() - t0).count();
+            print_replay_stats(stats, stdout);
+            printf("  replayed in %.2f ms (%.0fx real time)\n", ms, ms > 0.0 ? stats.durationNs / 1e6 / ms : 0.0);
+            return 0;
+        }
+    }
+
     // Load config
     load_config();
+    g_startup.mark("config load");
 
     // Initialize GLFW (used for both launcher and overlay windows)
     if(!glfwInit()) return -1;
+    g_startup.mark("glfwInit");
 
     // ---------------- Launcher window ----------------
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
@@ -233,48 +635,99 @@ int main(int argc, char** argv){
     if(!launcher){ glfwTerminate(); return -1; }
     glfwMakeContextCurrent(launcher);
     glfwSwapInterval(1);
+    g_startup.mark("launcher window");
     if(!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)){ std::cerr<<"Failed to initialize GLAD\n"; }
+    g_startup.mark("GLAD");
 
     // Setup ImGui context
+    ImGui::SetAllocatorFunctions(roro_imgui_alloc, roro_imgui_free); // counted like operator new (both contexts)
     IMGUI_CHECKVERSION(); ImGui::CreateContext(); ImGuiIO& io = ImGui::GetIO(); (void)io;
     ImGui::StyleColorsDark();
     ImGui_ImplGlfw_InitForOpenGL(launcher, true);
     ImGui_ImplOpenGL3_Init("#version 330");
+    g_startup.mark("ImGui init");
 
-    // Load background texture (optional)
+    // Load background texture (optional): decoded and downscaled to the framebuffer on a worker
+    // (or read back from roro_cache/), uploaded here once ready; a placeholder shows meanwhile.
     int bg_w=0, bg_h=0; GLuint bgTex = 0;
     const char* default_bg = "minecraft_bg.jpg"; // put an image next to exe or set path in config
-    bgTex = loadTextureFromFile(default_bg, bg_w, bg_h);
-
-    // create a second window for overlay
-    glfwWindowHint(GLFW_TRANSPARENT_FRAMEBUFFER, GLFW_TRUE);
-    glfwWindowHint(GLFW_DECORATED, GLFW_FALSE);
-    GLFWwindow* overlay = glfwCreateWindow(1280, 720, "Roro Overlay", NULL, NULL);
-    if(!overlay) { std::cerr<<"Overlay window failed to create\n"; }
-
-    // Prepare OpenGL for overlay
-    // We will use the overlay's OpenGL context when showing overlay
-
-    // positions map for panels
-    if(g_config.panels.empty()){
-        for(auto &name : PANEL_NAMES){
-            PanelConfig p; p.enabled = true; p.background = true; p.scale = 1.0f; p.movable = true; p.pos = ImVec2(50.0f, 50.0f+20.0f);
-            g_config.panels[name] = p;
-        }
-    }
+    AsyncImageLoader bgLoader;
+    { int fw, fh; glfwGetFramebufferSize(launcher, &fw, &fh); bgLoader.start(default_bg, fw, fh, []{ glfwPostEmptyEvent(); }); }
+
+    publish_config(); // load_config filled in the built-in panels
+    // wake the launcher loop (blocked in glfwWaitEvents) when the config file changes on disk
+    g_persist.onWritten(write_config_cache);
+    g_persist.start([]{ glfwPostEmptyEvent(); });
+
+    // The overlay (window, GL/ImGui context, render thread, input capture) is created lazily the
+    // first time it is shown, after the launcher has presented its first frame.
+    GLFWwindow* overlay = NULL;
+    bool overlayFailed = false;
+    std::thread overlayThread;
+    std::unique_ptr<InputSource> inputSource;
+    g_showOverlay = g_config.overlayShowOnStart;
+    bool firstFrame = true;
+    double firstFrameMB = 0.0;
+    ProcessState lastGameState = PROCESS_IDLE;
 
     // Main loop variables
-    bool showOverlay = true;
     bool overlayInteractive = true; // controlled by settings
-    auto last = Clock::now();
-    int frames = 0; float accum = 0.0f;
+    int settleFrames = 2; // ImGui needs a couple of frames after an event to reach a stable layout
+    std::string profileName = "default";
+    std::vector<std::string> profiles; bool profilesListed = false; // listed when Settings first opens
+
+    // The overlay runs only while it is wanted: shown in Settings and, with overlayFollowGame,
+    // while the launched game is running. Otherwise it is hidden, its thread sleeps and the
+    // input hooks are removed.
+    auto syncOverlay = [&](){
+        bool overlayWanted = g_showOverlay.load() && (!g_config.overlayFollowGame || g_game.running());
+        if(overlayWanted && !overlay && !overlayFailed){
+            // create a second window for overlay
+            glfwWindowHint(GLFW_TRANSPARENT_FRAMEBUFFER, GLFW_TRUE);
+            glfwWindowHint(GLFW_DECORATED, GLFW_FALSE);
+            glfwWindowHint(GLFW_FOCUS_ON_SHOW, GLFW_FALSE); // showing it must not take focus from the game
+            overlay = glfwCreateWindow(1280, 720, "Roro Overlay", NULL, NULL);
+            if(!overlay) { std::cerr<<"Overlay window failed to create\n"; overlayFailed = true; }
+            else {
+                g_startup.mark("overlay window");
+                if(const GLFWvidmode* vm = glfwGetVideoMode(glfwGetPrimaryMonitor())) g_displayHz = (float)vm->refreshRate;
+                // Keys and clicks are captured on their own thread, timestamped at the edge
+                inputSource = make_platform_input_source();
+                // The overlay renders on its own thread with its own context; window events stay on this one.
+                int ow, oh; glfwGetFramebufferSize(overlay, &ow, &oh);
+                g_overlayFbW = ow; g_overlayFbH = oh;
+                glfwGetWindowSize(overlay, &ow, &oh);
+                g_overlayWinW = ow; g_overlayWinH = oh;
+                glfwSetFramebufferSizeCallback(overlay, [](GLFWwindow*, int w, int h){ g_overlayFbW = w; g_overlayFbH = h; });
+                glfwSetWindowSizeCallback(overlay, [](GLFWwindow*, int w, int h){ g_overlayWinW = w; g_overlayWinH = h; });
+                overlayThread = std::thread(overlay_thread_main, overlay);
+            }
+        }
+        if(overlay && overlayWanted != g_overlayActive.load()){
+            if(overlayWanted){
+                glfwShowWindow(overlay);
+                if(inputSource && !inputSource->start(g_inputRing)){ std::cerr<<"Input capture ("<<inputSource->name()<<") failed to start\n"; inputSource.reset(); }
+            } else {
+                glfwHideWindow(overlay);
+                if(inputSource) inputSource->stop();
+            }
+            g_overlayActive = overlayWanted; wake_overlay();
+        }
+    };
 
     while(!glfwWindowShouldClose(launcher)){
-        // Launcher loop (we'll poll events from both windows)
-        glfwPollEvents();
+        // The launcher only redraws on input: block until an event arrives, then render a few frames.
+        if(settleFrames > 0){ glfwPollEvents(); settleFrames--; }
+        else { glfwWaitEvents(); settleFrames = 2; }
+        // Drags are saved once the panel settles (the persister debounces); external edits of the
+        // config file go live without a restart. Both while minimized too.
+        if(merge_overlay_positions()) save_config();
+        poll_config_reload();
+        // Minimized while the game runs is the common case: the overlay still follows the game.
+        if(glfwGetWindowAttrib(launcher, GLFW_ICONIFIED) || !glfwGetWindowAttrib(launcher, GLFW_VISIBLE)){ syncOverlay(); settleFrames = 0; continue; }
+        bool cfgChanged = false;
 
         // launcher rendering
-        glfwMakeContextCurrent(launcher);
         int lw, lh; glfwGetFramebufferSize(launcher, &lw, &lh);
         glViewport(0,0,lw,lh);
         glClearColor(0.07f,0.07f,0.08f,1.0f);
@@ -289,8 +742,13 @@ int main(int argc, char** argv){
         ImGui::Begin("Launcher", NULL, flags);
 
         // Background image (if loaded)
+        DecodedImage bgImg;
+        if(bgLoader.ready(bgImg)){ bgTex = uploadTexture(bgImg); bg_w = bgImg.w; bg_h = bgImg.h; g_startup.mark(bgImg.fromCache ? "texture load (cached)" : "texture load"); }
         if(bgTex){
             ImGui::GetWindowDrawList()->AddImage((void*)(intptr_t)bgTex, ImVec2(0,0), ImVec2((float)lw,(float)lh), ImVec2(0,0), ImVec2(1,1), IM_COL32(255,255,255,220));
+        } else if(bgLoader.pending()){
+            ImGui::GetWindowDrawList()->AddRectFilledMultiColor(ImVec2(0,0), ImVec2((float)lw,(float)lh),
+                IM_COL32(34,52,30,255), IM_COL32(34,52,30,255), IM_COL32(58,40,26,255), IM_COL32(58,40,26,255));
         }
 
         // Title
@@ -304,19 +762,14 @@ int main(int argc, char** argv){
         ImGui::SetCursorPosX((lw/2)-60);
         ImGui::SetCursorPosY((lh/2)-20);
         if(ImGui::Button("Launch", ImVec2(120,40))){
-            // launch Minecraft
-            if(launch_minecraft(g_config.minecraftPath)){
-                // success
-            } else {
-                // try to open path chooser
-                char buffer[MAX_PATH] = {0};
-                OPENFILENAMEA ofn; ZeroMemory(&ofn, sizeof(ofn)); ofn.lStructSize = sizeof(ofn); ofn.hwndOwner = NULL; ofn.lpstrFile = buffer; ofn.nMaxFile = MAX_PATH; ofn.lpstrFilter = "Executables\0*.exe\0All\0*.*\0";
-                ofn.Flags = OFN_FILEMUSTEXIST | OFN_PATHMUSTEXIST;
-                if(GetOpenFileNameA(&ofn)){
-                    g_config.minecraftPath = std::string(buffer);
-                    save_config();
-                }
-            }
+            // launch Minecraft (async; a failed start is picked up below)
+            if(g_config.minecraftPath.empty()) cfgChanged |= choose_minecraft_path();
+            else launch_minecraft(g_config.minecraftPath);
+        }
+        ProcessState gameState = g_game.state();
+        if(gameState != lastGameState){
+            if(gameState == PROCESS_FAILED) cfgChanged |= choose_minecraft_path();
+            lastGameState = gameState;
         }
 
         // Settings button
@@ -325,120 +778,103 @@ int main(int argc, char** argv){
             // open an ImGui modal for settings below
         }
 
+        // Game status, on its own line under the buttons
+        if(gameState != PROCESS_IDLE){
+            ImGui::SetCursorPosX((lw/2)-60);
+            if(gameState == PROCESS_RUNNING) ImGui::Text("Game running (pid %ld)", g_game.pid());
+            else if(gameState == PROCESS_EXITED) ImGui::Text("Game exited (%d)", g_game.exitCode());
+            else if(gameState == PROCESS_UNTRACKED) ImGui::Text("Game launched (not tracked)");
+            else ImGui::Text("Game %s", PROCESS_STATE_NAMES[gameState]);
+        }
+
         // Version in bottom-left
         ImGui::SetCursorPosX(10); ImGui::SetCursorPosY((float)lh - 30);
         ImGui::Text("Version: 1.0.0");
 
         // Settings modal / panel
         if(ImGui::CollapsingHeader("Settings")){
-            ImGui::InputText("Minecraft exe path", &g_config.minecraftPath);
-            ImGui::Checkbox("Overlay always on top", &g_config.overlayAlwaysOnTop);
-            ImGui::Checkbox("Overlay click-through", &g_config.overlayClickThrough);
-            if(ImGui::Button("Save config")) save_config();
+            cfgChanged |= ImGui::InputText("Minecraft exe path", &g_config.minecraftPath);
+            cfgChanged |= ImGui::Checkbox("Overlay always on top", &g_config.overlayAlwaysOnTop);
+            cfgChanged |= ImGui::Checkbox("Overlay click-through", &g_config.overlayClickThrough);
+            cfgChanged |= ImGui::Checkbox("Overlay: render only on change", &g_config.overlayRenderOnChange);
+            cfgChanged |= ImGui::Checkbox("FPS counter: frame stats", &g_config.overlayFrameStats);
+            cfgChanged |= ImGui::Checkbox("Overlay: batched HUD", &g_config.overlayBatchedHud);
+            int pacingMode = (int)g_config.overlayPacing.mode;
+            if(ImGui::Combo("Overlay pacing", &pacingMode, "Uncapped\0Fixed rate\0Match display\0")){ g_config.overlayPacing.mode = (PacingMode)pacingMode; cfgChanged = true; }
+            if(g_config.overlayPacing.mode == PACING_FIXED) cfgChanged |= ImGui::SliderFloat("Overlay target Hz", &g_config.overlayPacing.targetHz, 15.0f, 360.0f, "%.0f");
+            cfgChanged |= ImGui::Checkbox("Show overlay on start", &g_config.overlayShowOnStart);
+            cfgChanged |= ImGui::Checkbox("Overlay only while the game runs", &g_config.overlayFollowGame);
+            cfgChanged |= ImGui::Checkbox("Export metrics (shared memory, roro_metrics_cli)", &g_config.overlayMetricsExport);
+            if(ImGui::Button("Dump frame profile")) g_dumpProfile = true;
+            bool record = g_record.load();
+            if(ImGui::Checkbox("Record session (roro_session.rrec)", &record)) g_record = record;
+            if(ImGui::Button("Save config")) save_config(true);
             ImGui::Separator();
-            if(ImGui::Button(showOverlay ? "Hide Overlay" : "Show Overlay")) showOverlay = !showOverlay;
+            bool showOverlay = g_showOverlay.load();
+            if(ImGui::Button(showOverlay ? "Hide Overlay" : "Show Overlay")) g_showOverlay = !showOverlay;
             ImGui::Separator();
             ImGui::Text("Panels configuration");
             for(auto &kv : g_config.panels){
                 if(ImGui::TreeNode(kv.first.c_str())){
-                    ImGui::Checkbox("Enabled", &kv.second.enabled);
-                    ImGui::Checkbox("Background", &kv.second.background);
-                    ImGui::SliderFloat("Scale", &kv.second.scale, 0.5f, 2.0f);
-                    ImGui::ColorEdit4("Color", kv.second.color);
-                    ImGui::ColorEdit4("BG Color", kv.second.bgColor);
-                    ImGui::Checkbox("Movable", &kv.second.movable);
+                    cfgChanged |= ImGui::Checkbox("Enabled", &kv.second.enabled);
+                    cfgChanged |= ImGui::Checkbox("Background", &kv.second.background);
+                    cfgChanged |= ImGui::SliderFloat("Scale", &kv.second.scale, 0.5f, 2.0f);
+                    cfgChanged |= ImGui::ColorEdit4("Color", kv.second.color);
+                    cfgChanged |= ImGui::ColorEdit4("BG Color", kv.second.bgColor);
+                    cfgChanged |= ImGui::Checkbox("Movable", &kv.second.movable);
                     ImGui::TreePop();
                 }
             }
+            ImGui::Separator();
+            ImGui::Text("HUD profiles");
+            if(!profilesListed){ profiles = list_hud_profiles(); profilesListed = true; }
+            ImGui::InputText("Profile name", &profileName);
+            ImGui::SameLine();
+            if(ImGui::Button("Save layout")){
+                merge_overlay_positions();
+                if(save_hud_profile(profileName)) profiles = list_hud_profiles();
+                else std::cerr<<"Failed to save HUD profile '"<<profileName<<"'\n";
+            }
+            for(const std::string &name : profiles){
+                ImGui::PushID(name.c_str());
+                if(ImGui::Button("Load")){
+                    merge_overlay_positions(); // drags still in flight would land on the new layout
+                    if(load_hud_profile(name)){ profileName = name; cfgChanged = true; }
+                    else std::cerr<<"Failed to load HUD profile '"<<name<<"'\n";
+                }
+                ImGui::SameLine(); ImGui::TextUnformatted(name.c_str());
+                ImGui::PopID();
+            }
         }
 
         ImGui::End();
 
         ImGui::Render(); ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
         glfwSwapBuffers(launcher);
+        if(firstFrame){ g_startup.mark("first frame presented"); firstFrameMB = working_set_mb(); firstFrame = false; }
 
-        // ---------------- Overlay loop (render separately) ----------------
-        if(showOverlay && overlay){
-            glfwMakeContextCurrent(overlay);
-            if(g_config.overlayAlwaysOnTop){
-                HWND hwnd = GetActiveWindow(); // not ideal - we can find overlay HWND
-                HWND ovh = glfwGetWin32Window(overlay);
-                SetWindowPos(ovh, HWND_TOPMOST, 0,0,0,0, SWP_NOMOVE|SWP_NOSIZE);
-            }
-            // Click-through
-            HWND ovh = glfwGetWin32Window(overlay);
-            setWindowClickThrough(ovh, g_config.overlayClickThrough);
-
-            int ow, oh; glfwGetFramebufferSize(overlay, &ow, &oh);
-            glViewport(0,0,ow,oh);
-            glClearColor(0,0,0,0); // transparent background
-            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-            ImGui_ImplOpenGL3_NewFrame(); ImGui_ImplGlfw_NewFrame(); ImGui::NewFrame();
-
-            // Update time & fps
-            auto now = Clock::now(); float dt = std::chrono::duration_cast<std::chrono::duration<float>>(now - last).count(); last = now;
-            accum += dt; frames++; if(accum >= 0.5f){ g_fps = frames/accum; frames=0; accum=0.0f; }
-
-            // Input capture for keystrokes (poll via GetAsyncKeyState to detect while overlay may be click-through)
-            keyStateW = (GetAsyncKeyState('W') & 0x8000) != 0;
-            keyStateA = (GetAsyncKeyState('A') & 0x8000) != 0;
-            keyStateS = (GetAsyncKeyState('S') & 0x8000) != 0;
-            keyStateD = (GetAsyncKeyState('D') & 0x8000) != 0;
-            keyStateSpace = (GetAsyncKeyState(VK_SPACE) & 0x8000) != 0;
-
-            // click detection for CPS
-            static bool lastLeft = false;
-            bool curLeft = (GetAsyncKeyState(VK_LBUTTON) & 0x8000) != 0;
-            if(curLeft && !lastLeft){ clickTimes.push_back(Clock::now()); }
-            lastLeft = curLeft;
-
-            // HUD rendering for each panel (simple layout, movable windows)
-            for(auto &kv : g_config.panels){
-                const std::string &name = kv.first;
-                PanelConfig &p = kv.second;
-                if(!p.enabled) continue;
-                ImGui::SetNextWindowBgAlpha(p.background ? p.bgColor[3] : 0.0f);
-                ImGui::SetNextWindowSize(ImVec2(180.0f * p.scale, 30.0f * p.scale), ImGuiCond_Once);
-                ImGui::SetNextWindowPos(p.pos, ImGuiCond_Once);
-                ImGuiWindowFlags wflags = ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_AlwaysAutoResize;
-                if(!p.movable) wflags |= ImGuiWindowFlags_NoMove;
-                if(g_config.overlayClickThrough) wflags |= ImGuiWindowFlags_NoInputs;
-                ImGui::Begin(name.c_str(), NULL, wflags);
-                ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(6,4));
-                if(name == "FPS COUNTER"){
-                    ImGui::TextColored(ImVec4(p.color[0],p.color[1],p.color[2],p.color[3]), "FPS: %.1f", g_fps);
-                } else if(name == "CPS COUNTER"){
-                    ImGui::TextColored(ImVec4(p.color[0],p.color[1],p.color[2],p.color[3]), "CPS: %d", getCPS());
-                } else if(name == "KEYSTROKE"){
-                    ImGui::Text("W %s  A %s  S %s  D %s  Space %s",
-                        keyStateW?"[P]":"[ ]",
-                        keyStateA?"[P]":"[ ]",
-                        keyStateS?"[P]":"[ ]",
-                        keyStateD?"[P]":"[ ]",
-                        keyStateSpace?"[P]":"[ ]");
-                } else if(name == "REACH COUNTER"){
-                    ImGui::TextColored(ImVec4(p.color[0],p.color[1],p.color[2],p.color[3]), "Reach: %.2fm", lastReach);
-                } else if(name == "WATERMARK"){
-                    ImGui::TextColored(ImVec4(p.color[0],p.color[1],p.color[2],p.color[3]), "roro client");
-                } else {
-                    ImGui::Text("%s", name.c_str());
-                }
-                ImGui::PopStyleVar();
-                // record position for movable windows
-                ImVec2 pos = ImGui::GetWindowPos();
-                p.pos = pos;
-                ImGui::End();
-            }
+        syncOverlay();
 
-            ImGui::Render(); ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-            glfwSwapBuffers(overlay);
-        }
+        if(cfgChanged){ publish_config(); save_config(); }
+        // keep rendering while a widget is being dragged or typed into
+        if(ImGui::IsAnyMouseDown() || io.WantTextInput) settleFrames = 2;
+    }
 
+    if(startupTrace){
+        g_startup.print(stdout);
+        printf("Working set: %.1f MB at first frame, %.1f MB at exit\n", firstFrameMB, working_set_mb());
+        g_startup.write_chrome_trace("roro_startup.trace.json");
     }
 
     // Cleanup
-    save_config();
+    g_quit = true; wake_overlay();
+    if(overlayThread.joinable()) overlayThread.join();
+    if(inputSource) inputSource->stop();
+    g_game.stop(); // stop watching; the game keeps running
+    merge_overlay_positions();
+    save_config(true);
+    g_persist.stop(); // flushes the final write
+    if(bgTex) glDeleteTextures(1, &bgTex);
     ImGui_ImplOpenGL3_Shutdown(); ImGui_ImplGlfw_Shutdown(); ImGui::DestroyContext();
     if(overlay) glfwDestroyWindow(overlay);
     glfwDestroyWindow(launcher);
@@ -0,0 +1,247 @@
+// roro_metrics.h
+// Roro Client - live HUD metrics in shared memory, for streaming software and external tools
+// ---------------------------------------------------------------------------
+// The overlay publishes one MetricsSnapshot per loop iteration into a small named shared-memory
+// segment. Any process can map it read-only and sample it as often as it likes; a read is a
+// handful of loads and a memcpy, with no system call.
+// - Windows: named file mapping "Local\RoroMetrics" (CreateFileMapping / OpenFileMapping).
+// - POSIX:   shm_open("/roro_metrics") + mmap (link with -lrt on older glibc).
+// Segment layout (host byte order):
+//   MetricsHeader  - one cache line: magic, layout version, sizes, writer pid.
+//   MetricsBlock   - own cache line(s): seqlock counter + MetricsSnapshot.
+// The seqlock counter is odd while the writer is inside publish(). A reader copies the
+// snapshot between two reads of the counter and retries if it was odd or moved. There is one
+// writer and any number of readers; readers never block the writer.
+// Compatibility: new fields are only ever appended to MetricsSnapshot (snapshotSize grows).
+// Anything else bumps METRICS_VERSION, and readers refuse a version they don't know.
+// ---------------------------------------------------------------------------
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+static const char* METRICS_SHM_NAME = "Local\\RoroMetrics";
+#else
+static const char* METRICS_SHM_NAME = "/roro_metrics";
+#endif
+static const char METRICS_MAGIC[8] = { 'R', 'O', 'R', 'O', 'M', 'E', 'T', 'R' };
+static constexpr uint32_t METRICS_VERSION = 1;
+
+// Bits of MetricsSnapshot::keys (same order as InputCode in roro_input.h).
+enum MetricsKey : uint32_t {
+    METRICS_KEY_W = 1u << 0, METRICS_KEY_A = 1u << 1, METRICS_KEY_S = 1u << 2, METRICS_KEY_D = 1u << 3,
+    METRICS_KEY_SPACE = 1u << 4, METRICS_KEY_LBUTTON = 1u << 5, METRICS_KEY_RBUTTON = 1u << 6
+};
+
+// Bits of MetricsSnapshot::flags.
+enum MetricsFlag : uint32_t {
+    METRICS_FLAG_FRAME_STATS = 1u << 0, // frame-time fields are filled in
+    METRICS_FLAG_LATENCY     = 1u << 1  // latency fields are filled in
+};
+
+struct MetricsSnapshot {
+    uint64_t frame = 0;        // overlay loop iteration
+    uint64_t timeNs = 0;       // steady_clock (CLOCK_MONOTONIC / QPC), comparable across processes
+    uint32_t flags = 0;        // MetricsFlag
+    uint32_t keys = 0;         // MetricsKey: currently held
+    float fps = 0.0f;          // presented overlay frames per second
+    float cps[2] = {};         // clicks in the last second: left, right
+    float cps5s[2] = {};       // average over the last 5 s
+    float cpsAverage[2] = {};  // session average
+    uint32_t cpsPeak[2] = {};  // best 1 s this session
+    uint64_t clicks[2] = {};   // session totals
+    float reach = 0.0f;
+    float frameAvgMs = 0.0f, frameP99Ms = 0.0f, onePercentLowFps = 0.0f; // METRICS_FLAG_FRAME_STATS
+    float latencyP50Ms = 0.0f, latencyP99Ms = 0.0f;                       // METRICS_FLAG_LATENCY
+};
+
+struct alignas(64) MetricsHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;     // offset of the MetricsBlock
+    uint32_t snapshotSize;   // sizeof(MetricsSnapshot) of the writer
+    uint32_t writerPid;
+};
+
+struct alignas(64) MetricsBlock {
+    std::atomic<uint32_t> seq{0};
+    MetricsSnapshot data;
+};
+
+struct MetricsSegment {
+    MetricsHeader header;
+    MetricsBlock block;
+};
+static_assert(offsetof(MetricsSegment, block) % 64 == 0, "metrics block starts on its own cache line");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "seqlock counter must be lock-free to live in shared memory");
+
+// ------------------------------- Mapping ------------------------------------------
+// Owns one mapping of the segment. create = writer (read/write, created if missing).
+class MetricsMapping {
+public:
+    ~MetricsMapping(){ close(); }
+    MetricsMapping() {}
+    MetricsMapping(const MetricsMapping&) = delete;
+    MetricsMapping& operator=(const MetricsMapping&) = delete;
+
+    bool open(const char* name, bool create){
+        close();
+#ifdef _WIN32
+        handle_ = create ? CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, (DWORD)sizeof(MetricsSegment), name)
+                         : OpenFileMappingA(FILE_MAP_READ, FALSE, name);
+        if(!handle_) return false;
+        void* p = MapViewOfFile(handle_, create ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, 0, 0, 0);
+        if(!p){ close(); return false; }
+        MEMORY_BASIC_INFORMATION mbi;
+        size_ = VirtualQuery(p, &mbi, sizeof(mbi)) ? (size_t)mbi.RegionSize : sizeof(MetricsSegment);
+#else
+        fd_ = shm_open(name, create ? (O_CREAT | O_RDWR) : O_RDONLY, 0644);
+        if(fd_ < 0) return false;
+        struct stat st;
+        if(create){
+            if(ftruncate(fd_, (off_t)sizeof(MetricsSegment)) != 0){ close(); return false; }
+            size_ = sizeof(MetricsSegment);
+        } else {
+            if(fstat(fd_, &st) != 0 || (size_t)st.st_size < sizeof(MetricsHeader)){ close(); return false; }
+            size_ = (size_t)st.st_size;
+        }
+        void* p = mmap(nullptr, size_, create ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd_, 0);
+        if(p == MAP_FAILED){ close(); return false; }
+        ::close(fd_); fd_ = -1; // the mapping keeps the object alive
+#endif
+        base_ = p; owner_ = create; name_ = name;
+        return true;
+    }
+
+    // Unmaps; the writer also removes the name so readers see the overlay went away.
+    void close(){
+#ifdef _WIN32
+        if(base_) UnmapViewOfFile(base_);
+        if(handle_) CloseHandle(handle_);
+        handle_ = NULL;
+#else
+        if(base_) munmap(base_, size_);
+        if(fd_ >= 0) ::close(fd_);
+        fd_ = -1;
+        if(base_ && owner_) shm_unlink(name_);
+#endif
+        base_ = nullptr; size_ = 0; owner_ = false;
+    }
+
+    void* base() const { return base_; }
+    size_t size() const { return size_; }
+
+private:
+    void* base_ = nullptr;
+    size_t size_ = 0;
+    bool owner_ = false;
+    const char* name_ = nullptr;
+#ifdef _WIN32
+    HANDLE handle_ = NULL;
+#else
+    int fd_ = -1;
+#endif
+};
+
+// ------------------------------- Writer -------------------------------------------
+// One per process (the overlay thread). publish() is two stores and a memcpy.
+class MetricsPublisher {
+public:
+    bool open(const char* name = METRICS_SHM_NAME){
+        if(!map_.open(name, true)) return false;
+        seg_ = (MetricsSegment*)map_.base();
+        // a segment left behind by a crashed writer is taken over (ending a publish it died in)
+        uint32_t seq = seg_->block.seq.load(std::memory_order_relaxed);
+        if(seq & 1) seg_->block.seq.store(seq + 1, std::memory_order_release);
+        publish(MetricsSnapshot());
+        MetricsHeader &h = seg_->header;
+        h.version = METRICS_VERSION; h.headerSize = (uint32_t)offsetof(MetricsSegment, block);
+        h.snapshotSize = (uint32_t)sizeof(MetricsSnapshot);
+#ifdef _WIN32
+        h.writerPid = (uint32_t)GetCurrentProcessId();
+#else
+        h.writerPid = (uint32_t)getpid();
+#endif
+        std::atomic_thread_fence(std::memory_order_release);
+        memcpy(h.magic, METRICS_MAGIC, sizeof(h.magic)); // last: readers check it first
+        return true;
+    }
+    void close(){ map_.close(); seg_ = nullptr; }
+    bool active() const { return seg_ != nullptr; }
+
+    void publish(const MetricsSnapshot &s){
+        if(!seg_) return;
+        MetricsBlock &b = seg_->block;
+        uint32_t seq = b.seq.load(std::memory_order_relaxed);
+        b.seq.store(seq + 1, std::memory_order_relaxed);     // odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release); // ...and visible before the data
+        memcpy(&b.data, &s, sizeof(s));
+        b.seq.store(seq + 2, std::memory_order_release);
+    }
+
+private:
+    MetricsMapping map_;
+    MetricsSegment* seg_ = nullptr;
+};
+
+// ------------------------------- Reader -------------------------------------------
+// Maps the segment read-only once; read() then makes no system calls.
+class MetricsReader {
+public:
+    // False if no overlay has published, or it uses a layout version this reader doesn't know.
+    bool open(const char* name = METRICS_SHM_NAME){
+        if(!map_.open(name, false)) return false;
+        const MetricsSegment* seg = (const MetricsSegment*)map_.base();
+        const MetricsHeader &h = seg->header;
+        size_t dataOffset = (size_t)((const char*)&seg->block.data - (const char*)seg);
+        if(memcmp(h.magic, METRICS_MAGIC, sizeof(h.magic)) != 0 || h.version != METRICS_VERSION
+           || h.headerSize != offsetof(MetricsSegment, block) || map_.size() < dataOffset + h.snapshotSize){ close(); return false; }
+        seg_ = seg;
+        copySize_ = h.snapshotSize < sizeof(MetricsSnapshot) ? h.snapshotSize : sizeof(MetricsSnapshot);
+        return true;
+    }
+    void close(){ map_.close(); seg_ = nullptr; }
+    bool active() const { return seg_ != nullptr; }
+    uint32_t writerPid() const { return seg_ ? seg_->header.writerPid : 0; }
+
+    // Consistent copy of the latest snapshot. False if the writer kept it busy for maxSpins
+    // attempts (it only ever holds it for a memcpy). Fields an older writer lacks read as 0.
+    bool read(MetricsSnapshot &out, int maxSpins = 1000){
+        if(!seg_) return false;
+        const MetricsBlock &b = seg_->block;
+        for(int i = 0; i < maxSpins; i++){
+            uint32_t s1 = b.seq.load(std::memory_order_acquire);
+            if(s1 & 1){ retries_++; continue; }
+            MetricsSnapshot tmp;
+            memcpy(&tmp, &b.data, copySize_);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if(b.seq.load(std::memory_order_relaxed) != s1){ retries_++; continue; }
+            out = tmp;
+            return true;
+        }
+        return false;
+    }
+
+    uint64_t retries() const { return retries_; }
+
+private:
+    MetricsMapping map_;
+    const MetricsSegment* seg_ = nullptr;
+    size_t copySize_ = sizeof(MetricsSnapshot);
+    uint64_t retries_ = 0;
+};
@@ -0,0 +1,177 @@
+// roro_metrics_cli.cpp
+// Roro Client - reads the overlay's live metrics from shared memory (roro_metrics.h)
+// ---------------------------------------------------------------------------
+// BUILD
+//   g++ -O2 -std=c++17 roro_metrics_cli.cpp -I. -o roro_metrics_cli -lpthread   (add -lrt on older glibc)
+//   Windows: same, or add to any project; no libraries needed.
+// USAGE
+//   ./roro_metrics_cli [--hz N] [--count N] [--json]   sample the running overlay (default 10 Hz, forever);
+//                                                      follows it across restarts
+//   ./roro_metrics_cli --bench [reads]                 back-to-back reads: cost per read, retries
+//   ./roro_metrics_cli --selftest [seconds]            publish + read in this process under a test
+//                                                      name; fails on any torn read (exit code 1)
+//   ./roro_metrics_cli --help
+// ---------------------------------------------------------------------------
+
+#include "roro_metrics.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+using Clock = std::chrono::steady_clock;
+
+static uint64_t now_ns(){
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+static void print_text(const MetricsSnapshot &s, uint64_t ageNs){
+    static const char* keys[] = { "W", "A", "S", "D", "Space", "LMB", "RMB" };
+    printf("frame %8llu  fps %6.1f  cps %4.1f/%4.1f  peak %u/%u  clicks %llu/%llu  keys",
+        (unsigned long long)s.frame, s.fps, s.cps[0], s.cps[1], s.cpsPeak[0], s.cpsPeak[1],
+        (unsigned long long)s.clicks[0], (unsigned long long)s.clicks[1]);
+    for(int k = 0; k < 7; k++) printf(" %s", (s.keys >> k) & 1 ? keys[k] : "-");
+    if(s.flags & METRICS_FLAG_FRAME_STATS) printf("  frame %.2f ms p99 %.2f ms 1%%low %.0f", s.frameAvgMs, s.frameP99Ms, s.onePercentLowFps);
+    if(s.flags & METRICS_FLAG_LATENCY) printf("  latency p50 %.1f ms p99 %.1f ms", s.latencyP50Ms, s.latencyP99Ms);
+    if(ageNs > 1000000000ull) printf("  (stale %.1f s)", ageNs / 1e9);
+    printf("\n");
+}
+
+static void print_json(const MetricsSnapshot &s, uint64_t ageNs){
+    printf("{\"frame\":%llu,\"ageMs\":%.3f,\"fps\":%.2f,\"cps\":[%.2f,%.2f],\"cps5s\":[%.2f,%.2f],\"cpsAverage\":[%.2f,%.2f],"
+           "\"cpsPeak\":[%u,%u],\"clicks\":[%llu,%llu],\"keys\":%u,\"reach\":%.3f",
+        (unsigned long long)s.frame, ageNs / 1e6, s.fps, s.cps[0], s.cps[1], s.cps5s[0], s.cps5s[1], s.cpsAverage[0], s.cpsAverage[1],
+        s.cpsPeak[0], s.cpsPeak[1], (unsigned long long)s.clicks[0], (unsigned long long)s.clicks[1], s.keys, s.reach);
+    if(s.flags & METRICS_FLAG_FRAME_STATS) printf(",\"frameAvgMs\":%.3f,\"frameP99Ms\":%.3f,\"onePercentLowFps\":%.1f", s.frameAvgMs, s.frameP99Ms, s.onePercentLowFps);
+    if(s.flags & METRICS_FLAG_LATENCY) printf(",\"latencyP50Ms\":%.2f,\"latencyP99Ms\":%.2f", s.latencyP50Ms, s.latencyP99Ms);
+    printf("}\n");
+    fflush(stdout);
+}
+
+// ------------------------------- Sampling -----------------------------------------
+// A mapping keeps showing the segment it opened. When the overlay restarts it publishes into a
+// new one (POSIX unlinks the old name on exit), so once `frame` has not moved for STALL_NS the
+// reader closes and reopens by name, waiting for an overlay again if there is none.
+static const uint64_t STALL_NS = 2000000000ull;
+
+static int run_sample(double hz, long count, bool json){
+    MetricsReader reader;
+    uint32_t pid = 0;
+    uint64_t lastFrame = 0, movedNs = 0;
+    auto connect = [&]{
+        while(!reader.open()){
+            fprintf(stderr, "waiting for the overlay (%s)...\n", METRICS_SHM_NAME);
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+        if(reader.writerPid() != pid) fprintf(stderr, "reading metrics from pid %u\n", reader.writerPid());
+        pid = reader.writerPid(); movedNs = now_ns();
+    };
+    connect();
+    auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / hz));
+    auto next = Clock::now();
+    for(long i = 0; count <= 0 || i < count; i++){
+        MetricsSnapshot s;
+        uint64_t now = now_ns();
+        if(reader.read(s)){
+            if(s.frame != lastFrame){ lastFrame = s.frame; movedNs = now; }
+            uint64_t age = now > s.timeNs ? now - s.timeNs : 0;
+            if(json) print_json(s, age); else print_text(s, age);
+        }
+        if(now - movedNs > STALL_NS){ reader.close(); connect(); next = Clock::now(); } // idle or gone: look again
+        next += period;
+        std::this_thread::sleep_until(next);
+    }
+    return 0;
+}
+
+static int run_bench(const char* name, long reads){
+    MetricsReader reader;
+    if(!reader.open(name)){ fprintf(stderr, "no metrics segment (%s)\n", name); return 1; }
+    MetricsSnapshot s; uint64_t sink = 0, failed = 0;
+    auto t0 = Clock::now();
+    for(long i = 0; i < reads; i++){ if(reader.read(s)) sink += s.frame; else failed++; }
+    double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+    printf("%ld reads: %.1f ns/read, %llu retries, %llu failed  (checksum %llu)\n", reads, ns / reads,
+        (unsigned long long)reader.retries(), (unsigned long long)failed, (unsigned long long)sink);
+    return failed ? 1 : 0;
+}
+
+// ------------------------------- Self-test ----------------------------------------
+// A writer thread publishes as fast as it can; every field is derived from the frame number, so
+// a torn read shows up as fields that disagree.
+static void fill_test(MetricsSnapshot &s, uint64_t frame){
+    s.frame = frame; s.timeNs = now_ns();
+    s.fps = (float)(frame % 1000); s.cps[0] = s.fps + 1.0f; s.cps[1] = s.fps + 2.0f;
+    s.clicks[0] = frame * 3; s.clicks[1] = ~frame; s.keys = (uint32_t)(frame & 0x7f);
+    s.cpsPeak[0] = (uint32_t)frame; s.cpsPeak[1] = (uint32_t)(frame >> 32);
+}
+static bool consistent(const MetricsSnapshot &s){
+    uint64_t f = s.frame;
+    return s.fps == (float)(f % 1000) && s.cps[0] == s.fps + 1.0f && s.cps[1] == s.fps + 2.0f && s.clicks[0] == f * 3
+        && s.clicks[1] == ~f && s.keys == (uint32_t)(f & 0x7f) && s.cpsPeak[0] == (uint32_t)f && s.cpsPeak[1] == (uint32_t)(f >> 32);
+}
+
+static int run_selftest(double seconds){
+#ifdef _WIN32
+    const char* name = "Local\\RoroMetricsSelftest";
+#else
+    const char* name = "/roro_metrics_selftest";
+#endif
+    MetricsPublisher pub;
+    if(!pub.open(name)){ fprintf(stderr, "cannot create %s\n", name); return 1; }
+    MetricsReader reader;
+    if(!reader.open(name)){ fprintf(stderr, "cannot map %s\n", name); return 1; }
+
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> published{0};
+    std::thread writer([&]{
+        MetricsSnapshot s; uint64_t f = 1;
+        while(!stop.load(std::memory_order_relaxed)){ fill_test(s, f); pub.publish(s); f++; }
+        published = f - 1;
+    });
+    uint64_t reads = 0, torn = 0, failed = 0, lastFrame = 0, backwards = 0;
+    auto end = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+    while(Clock::now() < end){
+        for(int i = 0; i < 1024; i++){
+            MetricsSnapshot s;
+            if(!reader.read(s)){ failed++; std::this_thread::yield(); continue; } // let a preempted writer finish
+            reads++;
+            if(s.frame && !consistent(s)) torn++;
+            if(s.frame < lastFrame) backwards++;
+            lastFrame = s.frame;
+        }
+    }
+    stop = true; writer.join();
+    printf("selftest %.1f s: %llu publishes, %llu reads, %llu retries, %llu failed, %llu torn, %llu out of order\n", seconds,
+        (unsigned long long)published.load(), (unsigned long long)reads, (unsigned long long)reader.retries(),
+        (unsigned long long)failed, (unsigned long long)torn, (unsigned long long)backwards);
+    // A read gives up after 1000 busy spins, which should only happen while the writer is
+    // preempted mid-publish; more than 1 in 1000 reads failing means readers are starved.
+    bool ok = torn == 0 && backwards == 0 && reads > 0 && failed * 1000 <= reads;
+    printf("%s\n", ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+static void usage(FILE* out){
+    fprintf(out,
+        "usage: roro_metrics_cli [--hz N] [--count N] [--json]   sample the running overlay (default 10 Hz, forever)\n"
+        "       roro_metrics_cli --bench [reads]                 back-to-back reads: cost per read, retries\n"
+        "       roro_metrics_cli --selftest [seconds]            publish + read in this process; exit code 1 on a torn read\n");
+}
+
+int main(int argc, char** argv){
+    double hz = 10.0; long count = 0; bool json = false;
+    for(int i = 1; i < argc; i++){
+        if(strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0){ usage(stdout); return 0; }
+        if(strcmp(argv[i], "--bench") == 0) return run_bench(METRICS_SHM_NAME, i + 1 < argc && atol(argv[i + 1]) > 0 ? atol(argv[i + 1]) : 10000000);
+        if(strcmp(argv[i], "--selftest") == 0) return run_selftest(i + 1 < argc && atof(argv[i + 1]) > 0.0 ? atof(argv[i + 1]) : 2.0);
+        if(strcmp(argv[i], "--hz") == 0 && i + 1 < argc){ hz = atof(argv[++i]); if(hz <= 0.0) hz = 10.0; }
+        else if(strcmp(argv[i], "--count") == 0 && i + 1 < argc) count = atol(argv[++i]);
+        else if(strcmp(argv[i], "--json") == 0) json = true;
+        else { fprintf(stderr, "unknown or incomplete argument: %s\n", argv[i]); usage(stderr); return 2; }
+    }
+    return run_sample(hz, count, json);
+}
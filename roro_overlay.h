@@ -0,0 +1,170 @@
+// roro_overlay.h
+// Roro Client - per-frame overlay HUD build, independent of window, GL and Win32
+// ---------------------------------------------------------------------------
+// build_overlay_panels() is everything the overlay does between ImGui::NewFrame() and
+// ImGui::Render(). The Windows overlay thread drives it with the OpenGL3 renderer backend;
+// HeadlessOverlayBackend drives it with no window and no renderer at all (ImGui only needs a
+// display size and a built font atlas), which is what roro_overlay_bench.cpp measures.
+// Panels nobody is interacting with are drawn straight into one shared draw list (background,
+// text and graph share the font atlas texture, so ImGui merges them into a single draw command).
+// A panel only becomes a real ImGui window while the pointer is over it or dragging it.
+// ---------------------------------------------------------------------------
+#pragma once
+
+#include "imgui.h"
+#include "roro_alloc.h"
+#include "roro_panels.h"
+
+#include <cstdint>
+#include <vector>
+
+// ------------------------------- Panel drawing --------------------------------------
+// Interactive path: the panel as an auto-resizing ImGui window that can be dragged. Returns true
+// (and updates cfg.pos) if it moved this frame.
+inline bool draw_panel_window(PanelInstance &pi, const PanelContent &c, bool clickThrough){
+    const PanelConfig &p = pi.cfg;
+    ImGui::SetNextWindowBgAlpha(p.background ? p.bgColor[3] : 0.0f);
+    ImGui::SetNextWindowSize(ImVec2(180.0f * p.scale, 30.0f * p.scale), ImGuiCond_Once);
+    ImGui::SetNextWindowPos(p.pos, ImGuiCond_Appearing); // may have moved while batched
+    ImGuiWindowFlags wflags = ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_AlwaysAutoResize;
+    if(!p.movable) wflags |= ImGuiWindowFlags_NoMove;
+    if(clickThrough) wflags |= ImGuiWindowFlags_NoInputs;
+    ImGui::Begin(pi.name, NULL, wflags);
+    ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(6,4));
+    if(c.colored) ImGui::PushStyleColor(ImGuiCol_Text, panel_color(p));
+    ImGui::TextUnformatted(c.text, c.textEnd);
+    if(c.colored) ImGui::PopStyleColor();
+    if(c.graph) ImGui::PlotLines("##graph", c.graph, c.graphCount, c.graphOffset, NULL, 0.0f, c.graphMax, c.graphSize);
+    ImGui::PopStyleVar();
+    // record position for movable windows
+    ImVec2 pos = ImGui::GetWindowPos();
+    pi.size = ImGui::GetWindowSize();
+    pi.moved = pos.x != p.pos.x || pos.y != p.pos.y;
+    if(pi.moved) pi.cfg.pos = pos;
+    ImGui::End();
+    return pi.moved;
+}
+
+// Batched path: the same layout as draw_panel_window (window padding, border, item spacing,
+// plot frame), appended to `dl` with no window, ID or style stack involved.
+inline void draw_panel_batched(ImDrawList* dl, PanelInstance &pi, const PanelContent &c){
+    const ImGuiStyle &style = ImGui::GetStyle();
+    const PanelConfig &p = pi.cfg;
+    ImVec2 text = ImGui::CalcTextSize(c.text, c.textEnd);
+    ImVec2 inner = text;
+    if(c.graph){
+        inner.x = inner.x > c.graphSize.x ? inner.x : c.graphSize.x;
+        inner.y += style.ItemSpacing.y + c.graphSize.y;
+    }
+    ImVec2 size(inner.x + style.WindowPadding.x * 2, inner.y + style.WindowPadding.y * 2);
+    if(size.x < style.WindowMinSize.x) size.x = style.WindowMinSize.x;
+    if(size.y < style.WindowMinSize.y) size.y = style.WindowMinSize.y;
+    pi.size = size; pi.moved = false;
+
+    ImVec2 a = p.pos, b(p.pos.x + size.x, p.pos.y + size.y);
+    ImVec4 bg = style.Colors[ImGuiCol_WindowBg]; bg.w = p.background ? p.bgColor[3] : 0.0f;
+    if(bg.w > 0.0f) dl->AddRectFilled(a, b, ImGui::GetColorU32(bg), style.WindowRounding);
+    if(style.WindowBorderSize > 0.0f) dl->AddRect(a, b, ImGui::GetColorU32(ImGuiCol_Border), style.WindowRounding, 0, style.WindowBorderSize);
+
+    ImVec2 cur(a.x + style.WindowPadding.x, a.y + style.WindowPadding.y);
+    ImU32 textCol = c.colored ? ImGui::GetColorU32(panel_color(p)) : ImGui::GetColorU32(ImGuiCol_Text);
+    dl->AddText(ImGui::GetFont(), ImGui::GetFontSize(), cur, textCol, c.text, c.textEnd);
+    if(!c.graph || c.graphCount < 2) return;
+
+    // PlotLines equivalent: frame, then the ring drawn oldest to newest
+    cur.y += text.y + style.ItemSpacing.y;
+    ImVec2 fb(cur.x + c.graphSize.x, cur.y + c.graphSize.y);
+    dl->AddRectFilled(cur, fb, ImGui::GetColorU32(ImGuiCol_FrameBg), style.FrameRounding);
+    const ImVec2 pad(6,4); // FramePadding as pushed by draw_panel_window
+    float x0 = cur.x + pad.x, y1 = fb.y - pad.y, w = c.graphSize.x - pad.x * 2, h = c.graphSize.y - pad.y * 2;
+    int n = c.graphCount;
+    ImVec2* pts = frame_arena().array<ImVec2>((size_t)n);
+    for(int i = 0; i < n; i++){
+        float v = c.graph[(i + c.graphOffset) % c.graphCount] / c.graphMax;
+        v = v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+        pts[i] = ImVec2(x0 + w * i / (n - 1), y1 - h * v);
+    }
+    dl->AddPolyline(pts, n, ImGui::GetColorU32(ImGuiCol_PlotLines), 0, 1.0f);
+}
+
+// A panel becomes a window while hovered, and stays one for as long as the button is held so a
+// drag that leaves the panel's old rectangle is not cut off. Never when the overlay is click-through.
+inline bool panel_wants_window(PanelInstance &pi, bool clickThrough){
+    if(clickThrough || !pi.cfg.movable){ pi.interactive = false; return false; }
+    const ImGuiIO &io = ImGui::GetIO();
+    if(!io.MouseDown[0]){
+        const ImVec2 &m = io.MousePos, &a = pi.cfg.pos;
+        pi.interactive = m.x >= a.x && m.y >= a.y && m.x < a.x + pi.size.x && m.y < a.y + pi.size.y;
+    }
+    return pi.interactive;
+}
+
+// ------------------------------- Frame build ----------------------------------------
+// Draws every enabled panel: batched into the background draw list, or (batched = false, or the
+// panel is being interacted with) as its own ImGui window. Panels the user dragged get cfg.pos
+// updated and moved = true; returns how many moved this frame.
+inline int build_overlay_panels(std::vector<PanelInstance> &panels, const HudState &hud, bool clickThrough, bool batched = true){
+    ImDrawList* dl = batched ? ImGui::GetBackgroundDrawList() : nullptr;
+    int moved = 0;
+    for(PanelInstance &pi : panels){
+        PanelContent c;
+        pi.render(pi, hud, c);
+        if(!batched || panel_wants_window(pi, clickThrough)){
+            if(draw_panel_window(pi, c, clickThrough)) moved++;
+        } else {
+            draw_panel_batched(dl, pi, c);
+        }
+    }
+    return moved;
+}
+
+// ------------------------------- Draw statistics ------------------------------------
+struct DrawStats {
+    int drawLists = 0;
+    int drawCmds = 0;
+    int vertices = 0;
+    int indices = 0;
+};
+
+inline DrawStats draw_stats(const ImDrawData* dd){
+    DrawStats s;
+    if(!dd) return s;
+    s.drawLists = dd->CmdListsCount;
+    for(int i = 0; i < dd->CmdListsCount; i++) s.drawCmds += dd->CmdLists[i]->CmdBuffer.Size;
+    s.vertices = dd->TotalVtxCount; s.indices = dd->TotalIdxCount;
+    return s;
+}
+
+// ------------------------------- Headless backend -----------------------------------
+// Owns an ImGui context with a fixed display size and a built (never uploaded) font atlas.
+// Rendering is a no-op: the ImDrawData is produced and counted, nothing is submitted.
+class HeadlessOverlayBackend {
+public:
+    HeadlessOverlayBackend(float width = 1280.0f, float height = 720.0f){
+        ctx_ = ImGui::CreateContext();
+        ImGui::SetCurrentContext(ctx_);
+        ImGui::StyleColorsDark();
+        ImGuiIO &io = ImGui::GetIO();
+        io.DisplaySize = ImVec2(width, height);
+        io.IniFilename = NULL; // no imgui.ini traffic
+        unsigned char* px; int w, h;
+        io.Fonts->GetTexDataAsRGBA32(&px, &w, &h);
+        io.Fonts->SetTexID((ImTextureID)(intptr_t)1);
+    }
+    ~HeadlessOverlayBackend(){ ImGui::DestroyContext(ctx_); }
+    HeadlessOverlayBackend(const HeadlessOverlayBackend&) = delete;
+    HeadlessOverlayBackend& operator=(const HeadlessOverlayBackend&) = delete;
+
+    void newFrame(float dt){
+        ImGui::SetCurrentContext(ctx_);
+        ImGui::GetIO().DeltaTime = dt > 0.0f ? dt : 1.0f / 144.0f;
+        ImGui::NewFrame();
+    }
+    DrawStats render(){
+        ImGui::Render();
+        return draw_stats(ImGui::GetDrawData());
+    }
+
+private:
+    ImGuiContext* ctx_ = nullptr;
+};
@@ -0,0 +1,118 @@
+// roro_overlay_bench.cpp
+// Roro Client - headless overlay frame benchmark (no window, GPU or Win32)
+// ---------------------------------------------------------------------------
+// Drives build_overlay_panels() through HeadlessOverlayBackend for N frames at several panel
+// counts and reports per-frame CPU time, heap allocations and draw-data size, once with the
+// batched HUD path and once with one ImGui window per panel. Run it before and after an overlay
+// change to get a repeatable baseline.
+// It also checks that the batched path makes no heap allocation after warm-up (exit code 1 if
+// it does). The window-style call count is checked by roro_bench --selftest, which needs no ImGui.
+// BUILD (Dear ImGui core sources only, no backends)
+//   g++ -O2 -std=c++17 roro_overlay_bench.cpp imgui/imgui.cpp imgui/imgui_draw.cpp imgui/imgui_tables.cpp imgui/imgui_widgets.cpp -I. -Iimgui -DIMGUI_USER_CONFIG=\"roro_imconfig.h\" -o roro_overlay_bench
+// USAGE
+//   ./roro_overlay_bench [frames] [panels...]      (default: 2000 frames; 1 5 18 50 100 200 panels)
+// ---------------------------------------------------------------------------
+
+#include "imgui.h"
+#define RORO_ALLOC_IMPLEMENTATION
+#include "roro_alloc.h"
+#include "roro_overlay.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+
+thread_local ImGuiContext* RoroImGuiTLS = nullptr;
+
+// ------------------------------- Scenario -------------------------------------------
+// First the built-in panels in PANEL_NAMES order, then numbered custom panels, laid out on a grid.
+static std::map<std::string, PanelConfig> make_panels(int count){
+    std::map<std::string, PanelConfig> panels;
+    for(int i = 0; i < count; i++){
+        char name[32];
+        if(i < PANEL_BUILTIN_COUNT) snprintf(name, sizeof(name), "%s", PANEL_NAMES[i]);
+        else snprintf(name, sizeof(name), "PANEL %03d", i);
+        PanelConfig p; p.pos = ImVec2(10.0f + (i % 8) * 200.0f, 10.0f + (i / 8) * 40.0f);
+        panels[name] = p;
+    }
+    return panels;
+}
+
+struct BenchResult {
+    double avgUs = 0, p50Us = 0, p99Us = 0;
+    uint64_t allocs = 0; // after warm-up
+    double allocsPerFrame = 0, bytesPerFrame = 0;
+    DrawStats draw;
+};
+
+static BenchResult run_frames(int panelCount, int frames, bool batched){
+    const uint64_t frameNs = 6944444ull; // 144 Hz of simulated time
+    const int warmup = 120;
+    HeadlessOverlayBackend backend(1920.0f, 1080.0f);
+    PanelRegistry registry;
+    std::vector<PanelInstance> panels;
+    registry.build(make_panels(panelCount), panels);
+    static ClickStats clicks; clicks.reset();
+    std::vector<double> times; times.reserve(frames);
+
+    BenchResult r;
+    uint64_t t = 1000000000ull, nextClick = t;
+    AllocCounters allocStart;
+    for(int f = 0; f < warmup + frames; f++){
+        if(f == warmup) allocStart = thread_allocs();
+        t += frameNs;
+        while(nextClick <= t){ clicks.click(CLICK_LEFT, nextClick); nextClick += 70000000ull + (f % 7) * 3000000ull; }
+
+        auto t0 = std::chrono::steady_clock::now();
+        frame_arena().reset();
+        clicks.update(t);
+        HudState hud;
+        hud.fps = 144.0f + (float)((f / 72) % 3); hud.clicks = &clicks; hud.reach = 2.5f + (f % 50) * 0.01f;
+        hud.keyW = (f / 30) & 1; hud.keyA = (f / 45) & 1; hud.keyS = (f / 60) & 1; hud.keyD = (f / 75) & 1; hud.keySpace = (f / 90) & 1;
+        backend.newFrame(frameNs / 1e9f);
+        build_overlay_panels(panels, hud, true, batched);
+        DrawStats ds = backend.render();
+        double us = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count() / 1e3;
+
+        if(f >= warmup){ times.push_back(us); r.draw = ds; }
+    }
+    AllocCounters allocEnd = thread_allocs();
+    r.allocs = allocEnd.count - allocStart.count;
+    r.allocsPerFrame = (double)r.allocs / frames;
+    r.bytesPerFrame = (double)(allocEnd.bytes - allocStart.bytes) / frames;
+    double sum = 0; for(double v : times) sum += v;
+    r.avgUs = sum / frames;
+    std::sort(times.begin(), times.end());
+    r.p50Us = times[frames / 2]; r.p99Us = times[std::min(frames - 1, frames * 99 / 100)];
+    return r;
+}
+
+// ------------------------------- Window state ---------------------------------------
+int main(int argc, char** argv){
+    ImGui::SetAllocatorFunctions(roro_imgui_alloc, roro_imgui_free, NULL);
+    int frames = argc > 1 ? atoi(argv[1]) : 2000;
+    if(frames <= 0) frames = 2000;
+    std::vector<int> counts;
+    for(int i = 2; i < argc; i++) if(atoi(argv[i]) > 0) counts.push_back(atoi(argv[i]));
+    if(counts.empty()) counts = {1, 5, 18, 50, 100, 200};
+
+    bool allocFree = true;
+    printf("== Headless overlay frame: %d frames per run (after 120 warm-up) ==\n", frames);
+    printf("%8s %7s %10s %10s %10s %12s %12s %6s %6s %8s\n", "path", "panels", "avg us", "p50 us", "p99 us", "allocs/frm", "bytes/frm", "lists", "cmds", "verts");
+    for(int n : counts){
+        for(int batched = 1; batched >= 0; batched--){
+            BenchResult r = run_frames(n, frames, batched != 0);
+            printf("%8s %7d %10.2f %10.2f %10.2f %12.2f %12.1f %6d %6d %8d\n", batched ? "batched" : "windows", n, r.avgUs, r.p50Us, r.p99Us,
+                r.allocsPerFrame, r.bytesPerFrame, r.draw.drawLists, r.draw.drawCmds, r.draw.vertices);
+            if(batched && r.allocs) allocFree = false;
+        }
+    }
+    // the batched path is what the overlay runs every frame; after warm-up it must not allocate
+    printf("batched path heap allocations after warm-up: %s\n", allocFree ? "none  ok" : "FAIL");
+    return allocFree ? 0 : 1;
+}
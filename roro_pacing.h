@@ -0,0 +1,187 @@
+// roro_pacing.h
+// Roro Client - overlay frame pacing
+// ---------------------------------------------------------------------------
+// FrameScheduler decides when the overlay starts its next frame:
+// - uncapped: no waiting, no vsync (benchmarking only).
+// - fixed:    a target rate independent of the display. Deadlines advance by one period; the
+//             wait sleeps until shortly before the deadline and spins the rest, with the spin
+//             margin adapted to how late the OS actually wakes us.
+// - display:  vsync (swap interval 1) paces the loop; the scheduler only measures.
+// Every frame start is compared with where it should have been, giving a missed-deadline
+// count and the pacing jitter (standard deviation of that error).
+// ---------------------------------------------------------------------------
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#endif
+
+enum PacingMode { PACING_UNCAPPED, PACING_FIXED, PACING_DISPLAY, PACING_MODE_COUNT };
+
+static const char* PACING_MODE_NAMES[PACING_MODE_COUNT] = { "uncapped", "fixed", "display" };
+
+inline PacingMode pacing_mode_from_name(const std::string &name){
+    for(int i = 0; i < PACING_MODE_COUNT; i++) if(name == PACING_MODE_NAMES[i]) return (PacingMode)i;
+    return PACING_DISPLAY;
+}
+
+// As stored in roro_config.json ("overlayPacing").
+struct PacingConfig {
+    PacingMode mode = PACING_DISPLAY;
+    float targetHz = 60.0f; // fixed mode only
+};
+
+struct PacingStats {
+    PacingMode mode = PACING_DISPLAY;
+    float hz = 0.0f;          // target (fixed) or display refresh; 0 when unknown/uncapped
+    uint64_t frames = 0;      // frame starts measured
+    uint64_t missed = 0;      // started more than MISS_TOLERANCE after their deadline
+    float jitterMs = 0.0f;    // std deviation of the start error
+    float maxLateMs = 0.0f;
+};
+
+class FrameScheduler {
+public:
+    static constexpr uint64_t MISS_TOLERANCE_NS = 500000; // 0.5 ms
+
+    FrameScheduler(){
+#ifdef _WIN32
+        timer_ = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+#endif
+    }
+    ~FrameScheduler(){
+#ifdef _WIN32
+        if(timer_) CloseHandle(timer_);
+#endif
+    }
+    FrameScheduler(const FrameScheduler&) = delete;
+    FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+    static uint64_t now_ns(){
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // displayHz is the refresh rate of the overlay's monitor (0 if unknown). Resets the stats.
+    void configure(const PacingConfig &cfg, float displayHz){
+        mode_ = cfg.mode;
+        float hz = mode_ == PACING_FIXED ? cfg.targetHz : (mode_ == PACING_DISPLAY ? displayHz : 0.0f);
+        if(mode_ == PACING_FIXED && hz < 1.0f) hz = 1.0f;
+        hz_ = hz;
+        periodNs_ = hz > 0.0f ? (uint64_t)(1e9 / hz) : 0;
+        deadline_ = 0; last_ = 0; measureNext_ = false; meanInterval_ = 0.0;
+        resetStats();
+    }
+
+    // Swap interval to use with this mode (vsync only paces "display").
+    int swapInterval() const { return mode_ == PACING_DISPLAY ? 1 : 0; }
+    // True if wait() itself blocks (the loop need not throttle idle iterations).
+    bool paces() const { return mode_ == PACING_FIXED; }
+
+    // Called at the top of each loop iteration; blocks until the next frame is due (fixed mode).
+    // Returns the frame start time.
+    uint64_t wait(){
+        uint64_t now = now_ns();
+        if(uint64_t target = due(now)){ sleepUntil(target); now = now_ns(); }
+        started(now);
+        return now;
+    }
+
+    // wait() without the sleep, for callers with their own clock (roro_bench --selftest):
+    // due() is checked before waiting and returns the time to sleep until (0: start now), and
+    // started() takes the time the frame actually started.
+    uint64_t due(uint64_t now){
+        if(mode_ != PACING_FIXED) return 0;
+        if(!deadline_) deadline_ = now;
+        if(now > deadline_ + MISS_TOLERANCE_NS) missed_++;
+        if(now > deadline_ + periodNs_){ deadline_ = now; return 0; } // a whole period behind: resync, don't burst
+        return deadline_;
+    }
+    void started(uint64_t now){
+        if(mode_ == PACING_FIXED){
+            record(now > deadline_ ? (double)(now - deadline_) : -(double)(deadline_ - now));
+            deadline_ += periodNs_;
+        } else if(measureNext_ && last_){
+            double interval = (double)(now - last_);
+            double expected = periodNs_ ? (double)periodNs_ : (meanInterval_ ? meanInterval_ : interval);
+            if(periodNs_ && interval > expected * 1.5) missed_++; // a refresh went by without a frame
+            record(interval - expected);
+            meanInterval_ = meanInterval_ ? meanInterval_ * 0.95 + interval * 0.05 : interval;
+        }
+        last_ = now; measureNext_ = true;
+    }
+
+    // Start over from the next wait() without counting the gap (overlay was idle/hidden).
+    void resync(){ deadline_ = 0; measureNext_ = false; }
+
+    // The iteration that just started did not present (render-on-change skip, hidden overlay):
+    // don't count the gap to the next one as a pacing error.
+    void skipped(){ measureNext_ = false; }
+
+    PacingStats stats() const {
+        PacingStats s; s.mode = mode_; s.hz = hz_; s.frames = n_; s.missed = missed_;
+        if(n_){
+            double mean = sum_ / n_, var = sumSq_ / n_ - mean * mean;
+            s.jitterMs = (float)(std::sqrt(var > 0.0 ? var : 0.0) / 1e6);
+            s.maxLateMs = (float)(maxErr_ / 1e6);
+        }
+        return s;
+    }
+    void resetStats(){ n_ = 0; missed_ = 0; sum_ = sumSq_ = 0.0; maxErr_ = 0.0; }
+
+private:
+    void record(double errNs){
+        n_++; sum_ += errNs; sumSq_ += errNs * errNs;
+        if(errNs > maxErr_) maxErr_ = errNs;
+    }
+
+    // Hybrid wait: OS sleep up to spinNs_ before the target, then spin. The margin grows when a
+    // sleep overshoots into it and shrinks slowly back while sleeps are accurate.
+    void sleepUntil(uint64_t target){
+        uint64_t now = now_ns();
+        if(now + spinNs_ < target){
+            uint64_t want = target - spinNs_;
+            osSleep(want - now);
+            uint64_t woke = now_ns();
+            uint64_t over = woke > want ? woke - want : 0;
+            spinNs_ = over + 200000 > spinNs_ ? over + 200000 : spinNs_ - spinNs_ / 16;
+            if(spinNs_ < 200000) spinNs_ = 200000;
+            if(spinNs_ > 4000000) spinNs_ = 4000000;
+        }
+        while(now_ns() < target) std::this_thread::yield();
+    }
+
+    void osSleep(uint64_t ns){
+#ifdef _WIN32
+        if(timer_){
+            LARGE_INTEGER rel; rel.QuadPart = -(LONGLONG)(ns / 100); // relative, 100 ns units
+            if(SetWaitableTimer(timer_, &rel, 0, NULL, NULL, FALSE)){ WaitForSingleObject(timer_, INFINITE); return; }
+        }
+#endif
+        std::this_thread::sleep_for(std::chrono::nanoseconds(ns));
+    }
+
+    PacingMode mode_ = PACING_DISPLAY;
+    float hz_ = 0.0f;
+    uint64_t periodNs_ = 0, deadline_ = 0, last_ = 0;
+    uint64_t spinNs_ = 1000000;
+    bool measureNext_ = false;
+    double meanInterval_ = 0.0;
+    uint64_t n_ = 0, missed_ = 0;
+    double sum_ = 0.0, sumSq_ = 0.0, maxErr_ = 0.0;
+#ifdef _WIN32
+    HANDLE timer_ = NULL;
+#endif
+};
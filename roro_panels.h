@@ -0,0 +1,364 @@
+// roro_panels.h
+// Roro Client - HUD panel registry
+// ---------------------------------------------------------------------------
+// Panel types get stable integer IDs and register a render callback once. Render callbacks
+// only describe what the panel shows (PanelContent); drawing it is roro_overlay.h's job. The config layer
+// keeps addressing panels by name (load_config/save_config); names are resolved to IDs only
+// when the overlay takes a new config snapshot, and the frame loop walks a contiguous array of
+// the enabled panels with no string comparisons.
+// Each type can also register a signature function (the exact values it prints, rounded the way
+// its format string rounds them) and a refresh interval, so the overlay can tell whether a frame
+// would look any different from the last one it presented.
+// ---------------------------------------------------------------------------
+#pragma once
+
+#include "imgui.h"
+#include "roro_clickstats.h"
+#include "roro_config_schema.h"
+#include "roro_latency.h"
+#include "roro_pacing.h"
+#include "roro_profiler.h"
+
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+// ------------------------------- Panel config ---------------------------------------
+struct PanelConfig {
+    bool enabled = true;
+    bool background = true;
+    float scale = 1.0f;
+    float color[4] = {1.0f, 1.0f, 1.0f, 1.0f}; // rgba
+    float bgColor[4] = {0.0f,0.0f,0.0f,0.5f};
+    bool movable = true;
+    ImVec2 pos = ImVec2(100,100);
+};
+
+// The one place PanelConfig's fields are named: roro_config.json keys and the binary layout.
+template<> struct ConfigSchema<PanelConfig> {
+    template<typename S, typename V> static void fields(S &p, V &v){
+        v("enabled", p.enabled);
+        v("background", p.background);
+        v("scale", p.scale);
+        v("color", p.color);
+        v("bgColor", p.bgColor);
+        v("movable", p.movable);
+        v("pos", p.pos);
+    }
+};
+
+// Built-in panels. IDs are stable and index PANEL_NAMES; do not reorder.
+enum PanelId : uint16_t {
+    PANEL_FPS_COUNTER, PANEL_CPS_COUNTER, PANEL_KEYSTROKE, PANEL_REACH_COUNTER, PANEL_WATERMARK,
+    PANEL_MOOVABLE_CHAT, PANEL_MOOVABLE_UI, PANEL_MOOVABLE_SCOREBOARD, PANEL_FAST_INVENTORY, PANEL_JAVA_INVENTORY,
+    PANEL_ESP, PANEL_WHEATHER_CHANGER, PANEL_TIME_CHANGER, PANEL_FOV, PANEL_NAMETAGS, PANEL_HIDE_PSEUDO, PANEL_TWERK, PANEL_JAVA_MOVEMENTS,
+    PANEL_LATENCY,
+    PANEL_BUILTIN_COUNT
+};
+
+// defaults for panels
+static const char* PANEL_NAMES[PANEL_BUILTIN_COUNT] = {
+    "FPS COUNTER","CPS COUNTER","KEYSTROKE","REACH COUNTER","WATERMARK",
+    "MOOVABLE CHAT","MOOVABLE UI","MOOVABLE SCOREBOARD","FAST INVENTORY","JAVA INVENTORY",
+    "ESP","WHEATHER CHANGER","TIME CHANGER","FOV","NAMETAGS","HIDE_PSEUDO","TWERK","JAVA_MOVEMENTS",
+    "LATENCY"
+};
+
+// Values the panels display, gathered once per frame by the overlay.
+struct HudState {
+    float fps = 0.0f;
+    const ClickStats* clicks = nullptr;
+    bool keyW = false, keyA = false, keyS = false, keyD = false, keySpace = false;
+    float reach = 0.0f;
+    float skipRatio = -1.0f; // share of overlay frames skipped by render-on-change; <0 when off
+    const FrameProfiler* profiler = nullptr; // set when the FPS panel should show frame stats
+    FrameStats frameStats;
+    int drawCalls = -1, drawVertices = 0; // previous overlay frame's draw data; <0 when unknown
+    LatencyStats latency;                  // input-to-present, refreshed with the FPS value
+    PacingStats pacing;                    // shown with the frame stats
+};
+
+// What a panel shows this frame. Renderers only fill this in; the overlay decides how it is drawn
+// (batched into the shared HUD draw list, or inside an ImGui window while being dragged).
+struct PanelContent {
+    const char* text = "";
+    const char* textEnd = nullptr;
+    bool colored = false;          // panel color instead of the style's text color
+    const float* graph = nullptr;  // optional line graph below the text
+    int graphCount = 0, graphOffset = 0;
+    float graphMax = 1.0f;
+    ImVec2 graphSize = ImVec2(0,0);
+};
+
+// The values a panel prints, each quantized exactly as its format string rounds it, compared
+// field by field (never hashed): equal keys mean identical text.
+struct PanelKey {
+    static const int MAX = 16; // enough for the FPS panel with frame stats
+    int64_t v[MAX];
+    int n = 0;
+    PanelKey& operator<<(int64_t x){ if(n < MAX) v[n++] = x; return *this; }
+    bool operator==(const PanelKey &o) const { return n == o.n && memcmp(v, o.v, sizeof(v[0]) * n) == 0; }
+    bool operator!=(const PanelKey &o) const { return !(*this == o); }
+};
+
+struct PanelInstance;
+typedef void (*PanelRenderFn)(PanelInstance &panel, const HudState &hud, PanelContent &out);
+// Fills `key` with what the panel would display; equal keys mean an identical panel.
+typedef void (*PanelSignatureFn)(const HudState &hud, PanelKey &key);
+
+static const uint64_t PANEL_REFRESH_EVERY_FRAME = 0;
+static const uint64_t PANEL_REFRESH_NEVER = ~0ull;
+
+// Formatted panel text, kept until the values it was formatted from change.
+struct PanelText {
+    char buf[160];
+    int len = 0;
+    PanelKey key;
+    bool valid = false;
+};
+
+// One enabled panel, as the frame loop sees it.
+struct PanelInstance {
+    uint16_t id = 0;
+    PanelRenderFn render = nullptr;
+    const char* name = nullptr; // owned by the registry; stable for its lifetime
+    PanelSignatureFn signature = nullptr;
+    uint64_t refreshNs = PANEL_REFRESH_EVERY_FRAME;
+    PanelConfig cfg;
+    bool moved = false; // dragged to cfg.pos during the last frame
+    bool interactive = false; // drawn as its own ImGui window (hovered or being dragged)
+    ImVec2 size = ImVec2(0,0); // as last drawn, for hit-testing the batched path
+    PanelText text;
+    // render-on-change bookkeeping
+    PanelKey shownKey;
+    uint64_t nextSampleNs = 0;
+};
+
+// ------------------------------- Built-in signatures ---------------------------------
+// The same keys are the panels' text-cache keys, so they list every printed value.
+
+// What "%.<decimals>f" prints for v, as an integer (v * 10^decimals). printf rounds the exact
+// value half to even; a float times 1, 10 or 100 is exact in double, so nearbyint (round to
+// nearest even) makes the same call on ties that printf does.
+inline int64_t key_fixed(float v, int decimals){
+    static const double SCALE[] = { 1.0, 10.0, 100.0 };
+    double d = (double)v * SCALE[decimals];
+    if(!(std::fabs(d) < 9.0e18)){ uint32_t u; memcpy(&u, &v, sizeof(u)); return INT64_MIN + u; } // inf/nan print as words
+    return (int64_t)std::nearbyint(d);
+}
+
+inline void sig_fps_panel(const HudState &hud, PanelKey &k){
+    k << key_fixed(hud.fps, 1) << (hud.skipRatio >= 0.0f ? key_fixed(hud.skipRatio * 100.0f, 0) : -1);
+    if(!hud.profiler) return;
+    const FrameStats &fs = hud.frameStats;
+    const PacingStats &pc = hud.pacing;
+    k << key_fixed(fs.onePercentLowFps, 0) << key_fixed(fs.p99Ms, 1) << hud.drawCalls << hud.drawVertices << key_fixed(fs.allocsPerFrame, 1)
+      << (int64_t)pc.mode << (pc.hz > 0.0f ? key_fixed(pc.hz, 0) : -1) << (int64_t)pc.missed << key_fixed(pc.jitterMs, 2);
+}
+inline void sig_cps_panel(const HudState &hud, PanelKey &k){
+    const ClickStats &c = *hud.clicks;
+    k << c.count(CLICK_LEFT, CLICK_WINDOW_1S) << c.count(CLICK_RIGHT, CLICK_WINDOW_1S)
+      << key_fixed(c.rate(CLICK_LEFT, CLICK_WINDOW_5S), 1) << c.peak(CLICK_LEFT) << key_fixed(c.average(CLICK_LEFT), 1);
+}
+inline int keystroke_mask(const HudState &hud){
+    return (int)hud.keyW | (int)hud.keyA << 1 | (int)hud.keyS << 2 | (int)hud.keyD << 3 | (int)hud.keySpace << 4;
+}
+inline void sig_keystroke_panel(const HudState &hud, PanelKey &k){ k << keystroke_mask(hud); }
+inline void sig_reach_panel(const HudState &hud, PanelKey &k){ k << key_fixed(hud.reach, 2); }
+inline void sig_latency_panel(const HudState &hud, PanelKey &k){
+    const LatencyStats &l = hud.latency;
+    k << (l.count != 0);
+    if(l.count) k << key_fixed(l.p50Ms, 1) << key_fixed(l.p99Ms, 1) << key_fixed(l.minMs, 1);
+}
+inline void sig_static_panel(const HudState &, PanelKey &){}
+
+inline PanelKey panel_key(PanelSignatureFn sig, const HudState &hud){
+    PanelKey k;
+    sig(hud, k);
+    return k;
+}
+
+// ------------------------------- Text cache ----------------------------------------
+// printf into the panel's buffer only when `key` changed since the last call; otherwise the
+// arguments are ignored and the cached text is reused.
+inline const PanelText& panel_text(PanelInstance &pi, const PanelKey &key, const char* fmt, ...){
+    PanelText &t = pi.text;
+    if(t.valid && t.key == key) return t;
+    va_list args; va_start(args, fmt);
+    int n = vsnprintf(t.buf, sizeof(t.buf), fmt, args);
+    va_end(args);
+    t.len = n < 0 ? 0 : (n < (int)sizeof(t.buf) ? n : (int)sizeof(t.buf) - 1);
+    t.key = key; t.valid = true;
+    return t;
+}
+
+// Text built from several parts: returns true (with the buffer emptied) if `key` changed and the
+// caller should rebuild it with panel_text_append(); false if the cached text is still current.
+inline bool panel_text_stale(PanelInstance &pi, const PanelKey &key){
+    PanelText &t = pi.text;
+    if(t.valid && t.key == key) return false;
+    t.buf[0] = 0; t.len = 0; t.key = key; t.valid = true;
+    return true;
+}
+inline void panel_text_append(PanelInstance &pi, const char* fmt, ...){
+    PanelText &t = pi.text;
+    int room = (int)sizeof(t.buf) - t.len;
+    if(room <= 1) return;
+    va_list args; va_start(args, fmt);
+    int n = vsnprintf(t.buf + t.len, (size_t)room, fmt, args);
+    va_end(args);
+    if(n > 0) t.len += n < room ? n : room - 1;
+}
+
+inline ImVec4 panel_color(const PanelConfig &p){ return ImVec4(p.color[0],p.color[1],p.color[2],p.color[3]); }
+
+// Already-formatted text in the panel color; no format pass at draw time.
+inline void panel_text_colored(PanelContent &out, const PanelText &t){
+    out.text = t.buf; out.textEnd = t.buf + t.len; out.colored = true;
+}
+
+// All 32 KEYSTROKE lines, built once; indexed by keystroke_mask().
+inline const char* keystroke_text(int mask){
+    static char table[32][40];
+    static bool built = false;
+    if(!built){
+        for(int m = 0; m < 32; m++)
+            snprintf(table[m], sizeof(table[m]), "W %s  A %s  S %s  D %s  Space %s",
+                (m&1)?"[P]":"[ ]", (m&2)?"[P]":"[ ]", (m&4)?"[P]":"[ ]", (m&8)?"[P]":"[ ]", (m&16)?"[P]":"[ ]");
+        built = true;
+    }
+    return table[mask & 31];
+}
+
+// ------------------------------- Built-in renderers --------------------------------
+inline void render_fps_panel(PanelInstance &pi, const HudState &hud, PanelContent &out){
+    if(panel_text_stale(pi, panel_key(sig_fps_panel, hud))){
+        panel_text_append(pi, "FPS: %.1f", hud.fps);
+        if(hud.skipRatio >= 0.0f) panel_text_append(pi, "  skip %.0f%%", hud.skipRatio * 100.0f);
+        if(hud.profiler){
+            const PacingStats &pc = hud.pacing;
+            panel_text_append(pi, "\n1%% low %.0f  p99 %.1fms\n%d draws  %d verts  %.1f allocs", hud.frameStats.onePercentLowFps, hud.frameStats.p99Ms,
+                hud.drawCalls, hud.drawVertices, hud.frameStats.allocsPerFrame);
+            panel_text_append(pi, "\n%s", PACING_MODE_NAMES[pc.mode]);
+            if(pc.hz > 0.0f) panel_text_append(pi, " %.0fHz", pc.hz);
+            panel_text_append(pi, "  miss %llu  jitter %.2fms", (unsigned long long)pc.missed, pc.jitterMs);
+        }
+    }
+    panel_text_colored(out, pi.text);
+    if(hud.profiler){
+        out.graph = hud.profiler->graph(); out.graphCount = FrameProfiler::GRAPH; out.graphOffset = hud.profiler->graphOffset();
+        out.graphMax = 33.3f; out.graphSize = ImVec2(160.0f * pi.cfg.scale, 30.0f * pi.cfg.scale);
+    }
+}
+inline void render_cps_panel(PanelInstance &pi, const HudState &hud, PanelContent &out){
+    const ClickStats &c = *hud.clicks;
+    panel_text_colored(out, panel_text(pi, panel_key(sig_cps_panel, hud), "CPS: %d | %d\n5s %.1f  peak %d  avg %.1f",
+        c.count(CLICK_LEFT, CLICK_WINDOW_1S), c.count(CLICK_RIGHT, CLICK_WINDOW_1S),
+        c.rate(CLICK_LEFT, CLICK_WINDOW_5S), c.peak(CLICK_LEFT), c.average(CLICK_LEFT)));
+}
+inline void render_keystroke_panel(PanelInstance &, const HudState &hud, PanelContent &out){
+    out.text = keystroke_text(keystroke_mask(hud));
+}
+inline void render_reach_panel(PanelInstance &pi, const HudState &hud, PanelContent &out){
+    panel_text_colored(out, panel_text(pi, panel_key(sig_reach_panel, hud), "Reach: %.2fm", hud.reach));
+}
+inline void render_latency_panel(PanelInstance &pi, const HudState &hud, PanelContent &out){
+    const LatencyStats &l = hud.latency;
+    PanelKey key = panel_key(sig_latency_panel, hud);
+    panel_text_colored(out, l.count
+        ? panel_text(pi, key, "Latency p50 %.1fms  p99 %.1fms\nmin %.1fms", l.p50Ms, l.p99Ms, l.minMs)
+        : panel_text(pi, key, "Latency: --"));
+}
+inline void render_watermark_panel(PanelInstance &pi, const HudState &, PanelContent &out){
+    panel_text_colored(out, panel_text(pi, PanelKey(), "roro client"));
+}
+// Placeholder panels just show their name.
+inline void render_label_panel(PanelInstance &pi, const HudState &, PanelContent &out){
+    out.text = pi.name;
+}
+
+// ------------------------------- Registry -------------------------------------------
+class PanelRegistry {
+public:
+    PanelRegistry(){
+        for(int i = 0; i < PANEL_BUILTIN_COUNT; i++) add(PANEL_NAMES[i], render_label_panel);
+        add(PANEL_NAMES[PANEL_FPS_COUNTER], render_fps_panel, sig_fps_panel, 500000000ull); // g_fps itself updates every 0.5 s
+        add(PANEL_NAMES[PANEL_CPS_COUNTER], render_cps_panel, sig_cps_panel);
+        add(PANEL_NAMES[PANEL_KEYSTROKE], render_keystroke_panel, sig_keystroke_panel);
+        add(PANEL_NAMES[PANEL_REACH_COUNTER], render_reach_panel, sig_reach_panel);
+        add(PANEL_NAMES[PANEL_WATERMARK], render_watermark_panel);
+        add(PANEL_NAMES[PANEL_LATENCY], render_latency_panel, sig_latency_panel, 500000000ull); // stats refresh with the FPS value
+    }
+
+    // Registers a panel type (or replaces an existing one); returns its ID. Without a signature
+    // the panel is treated as static and never asks for a redraw by itself.
+    uint16_t add(const std::string &name, PanelRenderFn fn, PanelSignatureFn sig = sig_static_panel, uint64_t refreshNs = PANEL_REFRESH_EVERY_FRAME){
+        if(sig == sig_static_panel) refreshNs = PANEL_REFRESH_NEVER;
+        int id = find(name);
+        if(id < 0){
+            names_.push_back(new std::string(name));
+            renderers_.push_back(fn); signatures_.push_back(sig); refresh_.push_back(refreshNs);
+            return (uint16_t)(names_.size() - 1);
+        }
+        renderers_[id] = fn; signatures_[id] = sig; refresh_[id] = refreshNs;
+        return (uint16_t)id;
+    }
+
+    int find(const std::string &name) const {
+        for(size_t i = 0; i < names_.size(); i++) if(*names_[i] == name) return (int)i;
+        return -1;
+    }
+
+    const char* name(uint16_t id) const { return names_[id]->c_str(); }
+    PanelRenderFn renderer(uint16_t id) const { return renderers_[id]; }
+
+    // Resolve a config's panel map into the enabled-panel array the frame loop walks. Names the
+    // registry has never seen (custom entries in roro_config.json) get a label panel.
+    void build(const std::map<std::string, PanelConfig> &panels, std::vector<PanelInstance> &out){
+        out.clear();
+        for(auto &kv : panels){
+            if(!kv.second.enabled) continue;
+            int id = find(kv.first);
+            if(id < 0) id = add(kv.first, render_label_panel);
+            PanelInstance pi;
+            pi.id = (uint16_t)id; pi.render = renderers_[id]; pi.name = name((uint16_t)id); pi.cfg = kv.second;
+            pi.signature = signatures_[id]; pi.refreshNs = refresh_[id];
+            out.push_back(pi);
+        }
+    }
+
+    ~PanelRegistry(){ for(auto* s : names_) delete s; }
+    PanelRegistry(const PanelRegistry&) = delete;
+    PanelRegistry& operator=(const PanelRegistry&) = delete;
+
+private:
+    std::vector<std::string*> names_; // heap strings so name() pointers survive growth
+    std::vector<PanelRenderFn> renderers_;
+    std::vector<PanelSignatureFn> signatures_;
+    std::vector<uint64_t> refresh_;
+};
+
+// ------------------------------- Change detection -----------------------------------
+// True if any panel's displayed value moved since the last mark_panels_presented(). Panels are
+// only sampled at their own refresh interval, so a slow panel cannot force faster redraws.
+inline bool panels_changed(std::vector<PanelInstance> &panels, const HudState &hud, uint64_t nowNs){
+    bool changed = false;
+    for(PanelInstance &pi : panels){
+        if(pi.refreshNs == PANEL_REFRESH_NEVER || nowNs < pi.nextSampleNs) continue;
+        if(panel_key(pi.signature, hud) != pi.shownKey) changed = true;
+    }
+    return changed;
+}
+
+// Record what was just presented and schedule each panel's next sample.
+inline void mark_panels_presented(std::vector<PanelInstance> &panels, const HudState &hud, uint64_t nowNs){
+    for(PanelInstance &pi : panels){
+        pi.shownKey = panel_key(pi.signature, hud);
+        pi.nextSampleNs = pi.refreshNs == PANEL_REFRESH_NEVER ? PANEL_REFRESH_NEVER : nowNs + pi.refreshNs;
+    }
+}
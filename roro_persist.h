@@ -0,0 +1,189 @@
+// roro_persist.h
+// Roro Client - asynchronous, atomic, debounced config persistence with hot reload
+// ---------------------------------------------------------------------------
+// The UI thread hands over a copy of the value and returns immediately. A worker thread waits
+// out the debounce window (so a burst of edits or a panel drag becomes one write), serializes,
+// writes a temp file next to the target, flushes it to disk and renames it over the original
+// (then flushes the directory entry): a crash or power loss mid-write leaves the previous file
+// intact. An optional onWritten hook runs after each successful write
+// (e.g. to refresh a cache derived from the file). The same worker polls the file's modification time and,
+// when someone else changed it, parses it and queues the result for the UI thread to apply.
+// ---------------------------------------------------------------------------
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Write `data` to `path` via temp file + rename. Readers see either the old or the new file, and
+// the data is on disk (not just in the OS cache) before the rename makes it the new file.
+inline bool write_file_atomic(const std::string &path, const std::string &data){
+    std::string tmp = path + ".tmp";
+#ifdef _WIN32
+    HANDLE h = CreateFileA(tmp.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if(h == INVALID_HANDLE_VALUE) return false;
+    size_t off = 0; bool ok = true;
+    while(ok && off < data.size()){
+        DWORD chunk = (DWORD)(data.size() - off < (1u << 30) ? data.size() - off : (1u << 30)), n = 0;
+        ok = WriteFile(h, data.data() + off, chunk, &n, NULL) && n > 0;
+        off += n;
+    }
+    ok = ok && FlushFileBuffers(h);
+    ok = CloseHandle(h) && ok;
+    // WRITE_THROUGH: MoveFileEx returns only once the rename itself is flushed
+    if(!ok || !MoveFileExA(tmp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)){ DeleteFileA(tmp.c_str()); return false; }
+    return true;
+#else
+    int fd = open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if(fd < 0) return false;
+    size_t off = 0;
+    while(off < data.size()){
+        ssize_t n = write(fd, data.data() + off, data.size() - off);
+        if(n <= 0){ close(fd); unlink(tmp.c_str()); return false; }
+        off += (size_t)n;
+    }
+    bool ok = fsync(fd) == 0;
+    ok = (close(fd) == 0) && ok;
+    if(!ok || rename(tmp.c_str(), path.c_str()) != 0){ unlink(tmp.c_str()); return false; }
+    // the rename lives in the directory: flush that too, or power loss can bring back the old file
+    size_t slash = path.find_last_of('/');
+    std::string dir = slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+    int dfd = open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if(dfd >= 0){ fsync(dfd); close(dfd); }
+    return true;
+#endif
+}
+
+template<typename T>
+class ConfigPersister {
+public:
+    typedef std::function<std::string(const T&)> SerializeFn;
+    typedef std::function<bool(const std::string&, T&)> ParseFn;
+
+    ConfigPersister(std::string path, SerializeFn serialize, ParseFn parse)
+        : path_(std::move(path)), serialize_(std::move(serialize)), parse_(std::move(parse)) {}
+    ~ConfigPersister(){ stop(); }
+
+    // onReload runs on the worker after an external edit was parsed (e.g. to wake the UI loop).
+    void start(std::function<void()> onReload = nullptr,
+               std::chrono::milliseconds debounce = std::chrono::milliseconds(500),
+               std::chrono::milliseconds watchInterval = std::chrono::milliseconds(500)){
+        if(worker_.joinable()) return;
+        onReload_ = std::move(onReload); debounce_ = debounce; watchInterval_ = watchInterval;
+        knownStamp_ = stamp();
+        running_ = true;
+        worker_ = std::thread([this]{ run(); });
+    }
+
+    // Runs on the worker after `value` was written; set before start().
+    void onWritten(std::function<void(const T&)> fn){ onWritten_ = std::move(fn); }
+
+    // Flushes anything pending, then joins the worker.
+    void stop(){
+        if(!worker_.joinable()) return;
+        { std::lock_guard<std::mutex> lk(m_); running_ = false; }
+        cv_.notify_all();
+        worker_.join();
+    }
+
+    // Queue `value` for writing once no newer submit arrived for the debounce window.
+    // immediate = true skips the wait (explicit "Save" clicks).
+    void submit(const T &value, bool immediate = false){
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            pending_ = value; hasPending_ = true;
+            deadline_ = std::chrono::steady_clock::now() + (immediate ? std::chrono::milliseconds(0) : debounce_);
+        }
+        cv_.notify_all();
+    }
+
+    // UI thread: take the most recent externally reloaded value, if any.
+    bool takeReloaded(T &out){
+        std::lock_guard<std::mutex> lk(m_);
+        if(!hasReloaded_) return false;
+        out = reloaded_; hasReloaded_ = false;
+        return true;
+    }
+
+private:
+    typedef std::filesystem::file_time_type Stamp;
+
+    Stamp stamp() const {
+        std::error_code ec;
+        Stamp t = std::filesystem::last_write_time(path_, ec);
+        return ec ? Stamp::min() : t;
+    }
+
+    void run(){
+        std::unique_lock<std::mutex> lk(m_);
+        auto nextWatch = std::chrono::steady_clock::now() + watchInterval_;
+        while(true){
+            auto wake = hasPending_ && deadline_ < nextWatch ? deadline_ : nextWatch;
+            cv_.wait_until(lk, wake);
+            auto now = std::chrono::steady_clock::now();
+            if(hasPending_ && (now >= deadline_ || !running_)){
+                T value = pending_; hasPending_ = false;
+                lk.unlock();
+                std::string text = serialize_(value);
+                bool ok = write_file_atomic(path_, text);
+                if(ok && onWritten_) onWritten_(value);
+                Stamp s = stamp();
+                lk.lock();
+                if(ok) knownStamp_ = s;
+                else std::fprintf(stderr, "Failed to save %s\n", path_.c_str());
+            }
+            if(!running_) break;
+            if(now >= nextWatch){
+                nextWatch = now + watchInterval_;
+                Stamp s = stamp();
+                if(s != knownStamp_ && s != Stamp::min()){
+                    knownStamp_ = s;
+                    lk.unlock();
+                    std::ifstream in(path_, std::ios::binary);
+                    std::stringstream ss; ss << in.rdbuf();
+                    T value; bool ok = parse_(ss.str(), value);
+                    lk.lock();
+                    if(ok){
+                        // an external edit wins over a local change still waiting out its debounce
+                        reloaded_ = value; hasReloaded_ = true; hasPending_ = false;
+                        if(onReload_) onReload_();
+                    }
+                }
+            }
+        }
+    }
+
+    std::string path_;
+    SerializeFn serialize_;
+    ParseFn parse_;
+    std::function<void()> onReload_;
+    std::function<void(const T&)> onWritten_;
+    std::chrono::milliseconds debounce_{500}, watchInterval_{500};
+
+    std::mutex m_;
+    std::condition_variable cv_;
+    std::thread worker_;
+    bool running_ = false;
+    T pending_; bool hasPending_ = false;
+    std::chrono::steady_clock::time_point deadline_;
+    T reloaded_; bool hasReloaded_ = false;
+    Stamp knownStamp_;
+};
@@ -0,0 +1,322 @@
+// roro_process.h
+// Roro Client - game process launch and lifecycle tracking
+// ---------------------------------------------------------------------------
+// ChildProcess is a thin portable handle: spawn, poll/wait with a timeout, exit code.
+// - Windows: ShellExecuteEx (keeps the process handle), falling back to CreateProcess.
+// - POSIX:   posix_spawn + waitpid, so the same code runs against a stand-in child
+//            (e.g. /bin/sleep) on Linux.
+// GameLauncher runs the launch on a worker thread, keeps the handle and watches it until the
+// game exits, reporting each state change through a callback. The UI thread never blocks on it.
+// A launch the shell hands off without a process handle (store app activation) is untracked;
+// an optional locator can then find the game's process by name and watch that instead.
+// ---------------------------------------------------------------------------
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <objbase.h>
+#include <shellapi.h>
+#include <tlhelp32.h>
+#else
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <dirent.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+extern char** environ;
+#endif
+
+enum ProcessState {
+    PROCESS_IDLE,      // nothing launched yet
+    PROCESS_STARTING,  // launch in flight on the worker
+    PROCESS_RUNNING,
+    PROCESS_EXITED,
+    PROCESS_FAILED,    // could not be started
+    PROCESS_UNTRACKED  // started, but with no process to watch; can be launched again
+};
+
+inline constexpr const char* PROCESS_STATE_NAMES[] = { "idle", "starting", "running", "exited", "failed", "launched" };
+
+// ------------------------------- Child process -------------------------------------
+class ChildProcess {
+public:
+    ChildProcess() {}
+    ~ChildProcess(){ release(); }
+    ChildProcess(const ChildProcess&) = delete;
+    ChildProcess& operator=(const ChildProcess&) = delete;
+
+    // Starts `path` with `args`. A successful launch can still be untracked (tracked() == false)
+    // when the shell hands it to an already-running process or a store app activation.
+    bool spawn(const std::string &path, const std::vector<std::string> &args = std::vector<std::string>()){
+        release();
+#ifdef _WIN32
+        std::string params;
+        for(const std::string &a : args){ if(!params.empty()) params += ' '; params += '"' + a + '"'; }
+        SHELLEXECUTEINFOA sei; ZeroMemory(&sei, sizeof(sei)); sei.cbSize = sizeof(sei);
+        sei.fMask = SEE_MASK_NOCLOSEPROCESS | SEE_MASK_FLAG_NO_UI;
+        sei.lpVerb = "open"; sei.lpFile = path.c_str(); sei.lpParameters = params.empty() ? NULL : params.c_str();
+        sei.nShow = SW_SHOWNORMAL;
+        if(ShellExecuteExA(&sei)){ handle_ = sei.hProcess; started_ = true; return true; }
+        // fallback: try CreateProcess
+        std::string cmd = '"' + path + '"' + (params.empty() ? "" : " " + params);
+        STARTUPINFOA si; PROCESS_INFORMATION pi; ZeroMemory(&si, sizeof(si)); si.cb = sizeof(si); ZeroMemory(&pi, sizeof(pi));
+        if(!CreateProcessA(path.c_str(), &cmd[0], NULL, NULL, FALSE, 0, NULL, NULL, &si, &pi)) return false;
+        CloseHandle(pi.hThread);
+        handle_ = pi.hProcess; started_ = true;
+        return true;
+#else
+        std::vector<char*> argv;
+        argv.push_back(const_cast<char*>(path.c_str()));
+        for(const std::string &a : args) argv.push_back(const_cast<char*>(a.c_str()));
+        argv.push_back(nullptr);
+        pid_t pid;
+        if(posix_spawn(&pid, path.c_str(), nullptr, nullptr, argv.data(), environ) != 0) return false;
+        pid_ = pid; started_ = true;
+        return true;
+#endif
+    }
+
+    // Watches a process this one did not start (found by find_process_by_name). Its exit code is
+    // only known on Windows; elsewhere it reads -1.
+    bool attach(long pid){
+        release();
+        if(pid <= 0) return false;
+#ifdef _WIN32
+        handle_ = OpenProcess(SYNCHRONIZE | PROCESS_QUERY_LIMITED_INFORMATION, FALSE, (DWORD)pid);
+        if(!handle_) return false;
+#else
+        if(kill((pid_t)pid, 0) != 0 && errno != EPERM) return false;
+        pid_ = (pid_t)pid;
+#endif
+        started_ = true;
+        return true;
+    }
+
+    // Stops tracking but keeps the launch counted as started, the state a shell hand-off leaves
+    // (tests use it to stand in for a store app activation). The process keeps running.
+    void untrack(){
+#ifdef _WIN32
+        if(handle_) CloseHandle(handle_);
+        handle_ = NULL;
+#else
+        pid_ = -1;
+#endif
+    }
+
+    bool tracked() const {
+#ifdef _WIN32
+        return handle_ != NULL;
+#else
+        return pid_ > 0;
+#endif
+    }
+
+    // True once the process has exited (exitCode() is then valid). timeoutMs < 0 waits forever;
+    // 0 only polls. Untracked processes never report an exit.
+    bool wait(int timeoutMs){
+        if(exited_) return true;
+        if(!tracked()) return false;
+#ifdef _WIN32
+        if(WaitForSingleObject(handle_, timeoutMs < 0 ? INFINITE : (DWORD)timeoutMs) != WAIT_OBJECT_0) return false;
+        DWORD code = 0; GetExitCodeProcess(handle_, &code);
+        exitCode_ = (int)code; exited_ = true;
+        return true;
+#else
+        // waitpid has no timeout; poll at a coarse interval (only the monitor thread waits here)
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        while(true){
+            int status = 0;
+            pid_t r = waitpid(pid_, &status, WNOHANG);
+            if(r == pid_){
+                exitCode_ = WIFEXITED(status) ? WEXITSTATUS(status) : (WIFSIGNALED(status) ? 128 + WTERMSIG(status) : -1);
+                exited_ = true;
+                return true;
+            }
+            if(r < 0){
+                // not our child (attach()): all we can see is whether it still exists
+                if(errno != ECHILD || (kill(pid_, 0) != 0 && errno != EPERM)){ exitCode_ = -1; exited_ = true; return true; }
+            }
+            if(timeoutMs >= 0 && std::chrono::steady_clock::now() >= deadline) return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+#endif
+    }
+
+    bool started() const { return started_; }
+    bool exited() const { return exited_; }
+    int exitCode() const { return exitCode_; }
+    long pid() const {
+#ifdef _WIN32
+        return handle_ ? (long)GetProcessId(handle_) : 0;
+#else
+        return (long)pid_;
+#endif
+    }
+
+    // Drops the handle; the process itself keeps running.
+    void release(){
+#ifdef _WIN32
+        if(handle_) CloseHandle(handle_);
+        handle_ = NULL;
+#else
+        pid_ = -1; // a POSIX child that outlives us is reparented; nothing to close
+#endif
+        started_ = exited_ = false; exitCode_ = 0;
+    }
+
+private:
+#ifdef _WIN32
+    HANDLE handle_ = NULL;
+#else
+    pid_t pid_ = -1;
+#endif
+    bool started_ = false, exited_ = false;
+    int exitCode_ = 0;
+};
+
+// Pid of a running process whose executable file name is `name` (e.g. "Minecraft.Windows.exe";
+// case-insensitive on Windows), 0 if there is none.
+inline long find_process_by_name(const std::string &name){
+#ifdef _WIN32
+    HANDLE snap = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+    if(snap == INVALID_HANDLE_VALUE) return 0;
+    PROCESSENTRY32 pe; pe.dwSize = sizeof(pe);
+    long pid = 0;
+    for(BOOL ok = Process32First(snap, &pe); ok && !pid; ok = Process32Next(snap, &pe))
+        if(lstrcmpiA(pe.szExeFile, name.c_str()) == 0) pid = (long)pe.th32ProcessID;
+    CloseHandle(snap);
+    return pid;
+#else
+    // /proc/<pid>/comm holds the first 15 characters of the name
+    std::string want = name.substr(0, 15);
+    long pid = 0;
+    if(DIR* d = opendir("/proc")){
+        while(dirent* e = readdir(d)){
+            long p = strtol(e->d_name, nullptr, 10);
+            if(p <= 0) continue;
+            std::string path = std::string("/proc/") + e->d_name + "/comm";
+            char comm[32] = {0};
+            if(FILE* f = fopen(path.c_str(), "r")){ if(!fgets(comm, sizeof(comm), f)) comm[0] = 0; fclose(f); }
+            std::string c = comm;
+            if(!c.empty() && c.back() == '\n') c.pop_back();
+            if(c == want){ pid = p; break; }
+        }
+        closedir(d);
+    }
+    return pid;
+#endif
+}
+
+// ------------------------------- Async launcher ------------------------------------
+// launch() returns immediately; the worker spawns the game and then watches it until it exits
+// (or stop() is called, which leaves the game running). onChange runs on the worker.
+// States: IDLE -> STARTING -> RUNNING -> EXITED, or -> FAILED, or -> UNTRACKED when the launch
+// left no handle. UNTRACKED moves on to RUNNING if the locator finds the game in time.
+class GameLauncher {
+public:
+    typedef std::function<void(ProcessState)> StateFn;
+    typedef std::function<bool(ChildProcess&, const std::string&, const std::vector<std::string>&)> SpawnFn;
+    typedef std::function<long()> LocateFn;
+
+    ~GameLauncher(){ stop(); }
+
+    // Replaces ChildProcess::spawn as the way the worker starts the game (tests, stand-ins).
+    // Set before the first launch().
+    void setSpawn(SpawnFn spawn){ spawn_ = std::move(spawn); }
+
+    // False if a launch is already starting or the game is still running. An untracked launch
+    // does not block a new one. If this launch is left untracked, the worker calls `locate`
+    // (e.g. find_process_by_name) every locatePollMs until it returns a pid or locateTimeoutMs
+    // passes. The locator is only stored once the previous worker has been joined.
+    bool launch(const std::string &path, std::vector<std::string> args = std::vector<std::string>(), StateFn onChange = nullptr,
+                LocateFn locate = nullptr, int locateTimeoutMs = 30000, int locatePollMs = 500){
+        ProcessState s = state();
+        if(s == PROCESS_STARTING || s == PROCESS_RUNNING) return false;
+        if(s == PROCESS_UNTRACKED) stop_ = true; // the worker may still be looking for the game
+        if(worker_.joinable()) worker_.join();
+        locate_ = std::move(locate); locateTimeoutMs_ = locateTimeoutMs; locatePollMs_ = locatePollMs;
+        stop_ = false; exitCode_ = 0; pid_ = 0;
+        setState(PROCESS_STARTING, onChange);
+        worker_ = std::thread([this, path, args, onChange]{
+#ifdef _WIN32
+            CoInitializeEx(NULL, COINIT_APARTMENTTHREADED | COINIT_DISABLE_OLE1DDE); // ShellExecuteEx wants COM
+#endif
+            run(path, args, onChange);
+#ifdef _WIN32
+            CoUninitialize();
+#endif
+        });
+        return true;
+    }
+
+    // Stops watching (exit path); the game is not terminated.
+    void stop(){
+        stop_ = true;
+        if(worker_.joinable()) worker_.join();
+    }
+
+    ProcessState state() const { return state_.load(); }
+    bool running() const { return state() == PROCESS_RUNNING; }
+    int exitCode() const { return exitCode_.load(); }
+    long pid() const { return pid_.load(); }
+
+private:
+    void run(const std::string &path, const std::vector<std::string> &args, const StateFn &onChange){
+        ChildProcess proc;
+        if(!(spawn_ ? spawn_(proc, path, args) : proc.spawn(path, args))){ setState(PROCESS_FAILED, onChange); return; }
+        if(!proc.tracked()){
+            setState(PROCESS_UNTRACKED, onChange);
+            if(!locate(proc)) return; // launched, but nothing to watch
+        }
+        pid_ = proc.pid();
+        setState(PROCESS_RUNNING, onChange);
+        while(!stop_.load()){
+            if(proc.wait(250)){
+                exitCode_ = proc.exitCode();
+                setState(PROCESS_EXITED, onChange);
+                return;
+            }
+        }
+    }
+
+    bool locate(ChildProcess &proc){
+        if(!locate_) return false;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(locateTimeoutMs_);
+        while(!stop_.load()){
+            long pid = locate_();
+            if(pid > 0 && proc.attach(pid)) return true;
+            if(std::chrono::steady_clock::now() >= deadline) return false;
+            for(int waited = 0; waited < locatePollMs_ && !stop_.load(); waited += 50)
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+        return false;
+    }
+
+    void setState(ProcessState s, const StateFn &onChange){
+        state_ = s;
+        if(onChange) onChange(s);
+    }
+
+    std::thread worker_;
+    std::atomic<ProcessState> state_{PROCESS_IDLE};
+    std::atomic<bool> stop_{false};
+    std::atomic<int> exitCode_{0};
+    std::atomic<long> pid_{0};
+    SpawnFn spawn_;
+    LocateFn locate_;                      // written only while no worker runs
+    int locateTimeoutMs_ = 30000, locatePollMs_ = 500;
+};
@@ -0,0 +1,227 @@
+// roro_profiler.h
+// Roro Client - overlay frame-time profiler
+// ---------------------------------------------------------------------------
+// Every presented overlay frame is recorded (total time plus per-stage split) into a fixed
+// ring. Percentiles (p50/p95/p99) and the 1% low are recomputed on demand from that ring, and
+// a snapshot can be written out as CSV or as Chrome trace JSON (chrome://tracing, Perfetto).
+// Recording is a handful of clock reads per frame and never allocates. Each frame also carries
+// the heap allocations the recording thread made during it (roro_alloc.h counters).
+// StartupTrace (bottom) does the same for one-off init phases.
+// ---------------------------------------------------------------------------
+#pragma once
+
+#include "roro_alloc.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+enum FrameStage {
+    STAGE_EVENTS,    // config snapshot + window styles
+    STAGE_INPUT,     // input drain + click stats
+    STAGE_NEWFRAME,  // backend + ImGui NewFrame
+    STAGE_PANELS,    // panel build
+    STAGE_RENDER,    // ImGui::Render + draw data submission
+    STAGE_SWAP,      // glfwSwapBuffers
+    STAGE_COUNT
+};
+
+static const char* FRAME_STAGE_NAMES[STAGE_COUNT] = { "events", "input", "newframe", "panels", "render", "swap" };
+
+struct FrameRecord {
+    uint64_t startNs = 0;              // steady_clock
+    uint32_t frameNs = 0;              // start of this frame to start of the next
+    uint32_t stageNs[STAGE_COUNT] = {};
+    uint32_t allocs = 0, allocBytes = 0; // heap traffic on this thread during the frame
+};
+
+struct FrameStats {
+    uint32_t count = 0;
+    float avgMs = 0, p50Ms = 0, p95Ms = 0, p99Ms = 0, maxMs = 0;
+    float onePercentLowFps = 0;        // average fps over the slowest 1% of frames
+    float allocsPerFrame = 0;
+    uint32_t maxAllocs = 0;            // worst single frame
+};
+
+class FrameProfiler {
+public:
+    static constexpr uint32_t CAPACITY = 4096; // ~28 s at 144 Hz
+    static constexpr uint32_t GRAPH = 128;     // frame-time graph length
+
+    static uint64_t now_ns(){
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Starts a frame; closes the previous one (its frameNs runs up to this start).
+    void beginFrame(){ beginFrame(now_ns()); }
+    void beginFrame(uint64_t t){
+        if(open_) commit(t);
+        cur_ = FrameRecord(); cur_.startNs = t; mark_ = t; open_ = true;
+        allocStart_ = thread_allocs();
+    }
+    // Ends `stage` at the current time (time since the previous mark or frame start).
+    void mark(FrameStage stage){ mark(stage, now_ns()); }
+    void mark(FrameStage stage, uint64_t t){
+        if(!open_) return;
+        cur_.stageNs[stage] += (uint32_t)(t - mark_); mark_ = t;
+    }
+    // Drop the frame in progress (e.g. render-on-change decided not to present it).
+    void cancelFrame(){ open_ = false; }
+
+    uint32_t size() const { return count_ < CAPACITY ? count_ : CAPACITY; }
+    // i = 0 is the oldest retained frame.
+    const FrameRecord& at(uint32_t i) const { return ring_[(count_ - size() + i) % CAPACITY]; }
+
+    // Recent frame times in ms for ImGui::PlotLines (values, GRAPH, graphOffset()).
+    const float* graph() const { return graph_; }
+    int graphOffset() const { return (int)(count_ % GRAPH); }
+
+    // Percentiles over every retained frame. O(n log n); call at a low rate (e.g. with the FPS update).
+    FrameStats computeStats(){
+        FrameStats s; uint32_t n = size();
+        if(!n) return s;
+        uint64_t sum = 0, allocs = 0;
+        for(uint32_t i = 0; i < n; i++){
+            const FrameRecord &r = at(i);
+            scratch_[i] = r.frameNs; sum += scratch_[i];
+            allocs += r.allocs; s.maxAllocs = std::max(s.maxAllocs, r.allocs);
+        }
+        s.allocsPerFrame = (float)allocs / n;
+        std::sort(scratch_, scratch_ + n);
+        auto pct = [&](float q){ return scratch_[std::min(n - 1, (uint32_t)(q * (n - 1) + 0.5f))] / 1e6f; };
+        s.count = n; s.avgMs = (float)(sum / n) / 1e6f;
+        s.p50Ms = pct(0.50f); s.p95Ms = pct(0.95f); s.p99Ms = pct(0.99f); s.maxMs = scratch_[n - 1] / 1e6f;
+        uint32_t worst = std::max<uint32_t>(1, n / 100); uint64_t worstSum = 0;
+        for(uint32_t i = n - worst; i < n; i++) worstSum += scratch_[i];
+        s.onePercentLowFps = worstSum ? (float)(1e9 * worst / (double)worstSum) : 0.0f;
+        return s;
+    }
+
+    // Copy of the retained frames, oldest first (for writing off the render thread).
+    std::vector<FrameRecord> snapshot() const {
+        std::vector<FrameRecord> out(size());
+        for(uint32_t i = 0; i < out.size(); i++) out[i] = at(i);
+        return out;
+    }
+
+private:
+    void commit(uint64_t t){
+        cur_.frameNs = (uint32_t)std::min<uint64_t>(t - cur_.startNs, 0xffffffffu);
+        AllocCounters a = thread_allocs();
+        cur_.allocs = (uint32_t)(a.count - allocStart_.count); cur_.allocBytes = (uint32_t)(a.bytes - allocStart_.bytes);
+        ring_[count_ % CAPACITY] = cur_;
+        graph_[count_ % GRAPH] = cur_.frameNs / 1e6f;
+        count_++; open_ = false;
+    }
+
+    FrameRecord ring_[CAPACITY];
+    uint32_t scratch_[CAPACITY];
+    float graph_[GRAPH] = {};
+    FrameRecord cur_;
+    uint64_t mark_ = 0;
+    AllocCounters allocStart_;
+    uint32_t count_ = 0;
+    bool open_ = false;
+};
+
+// ------------------------------- Export -------------------------------------------
+// One row per frame: start (us, relative to the first frame), frame time, each stage in us, and
+// the frame's heap allocations.
+inline bool write_frames_csv(const std::vector<FrameRecord> &frames, const char* path){
+    FILE* f = fopen(path, "w");
+    if(!f) return false;
+    fprintf(f, "start_us,frame_us");
+    for(int s = 0; s < STAGE_COUNT; s++) fprintf(f, ",%s_us", FRAME_STAGE_NAMES[s]);
+    fprintf(f, ",allocs,alloc_bytes\n");
+    uint64_t base = frames.empty() ? 0 : frames[0].startNs;
+    for(const FrameRecord &r : frames){
+        fprintf(f, "%.3f,%.3f", (r.startNs - base) / 1e3, r.frameNs / 1e3);
+        for(int s = 0; s < STAGE_COUNT; s++) fprintf(f, ",%.3f", r.stageNs[s] / 1e3);
+        fprintf(f, ",%u,%u\n", r.allocs, r.allocBytes);
+    }
+    return fclose(f) == 0;
+}
+
+// Chrome trace event format: one "frame" slice per frame with its stages nested inside.
+inline bool write_frames_chrome_trace(const std::vector<FrameRecord> &frames, const char* path){
+    FILE* f = fopen(path, "w");
+    if(!f) return false;
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    uint64_t base = frames.empty() ? 0 : frames[0].startNs;
+    bool first = true;
+    for(const FrameRecord &r : frames){
+        double t = (r.startNs - base) / 1e3;
+        fprintf(f, "%s{\"name\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}", first ? "" : ",\n", t, r.frameNs / 1e3);
+        first = false;
+        for(int s = 0; s < STAGE_COUNT; s++){
+            if(!r.stageNs[s]) continue;
+            fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}", FRAME_STAGE_NAMES[s], t, r.stageNs[s] / 1e3);
+            t += r.stageNs[s] / 1e3;
+        }
+    }
+    fprintf(f, "\n]}\n");
+    return fclose(f) == 0;
+}
+
+// ------------------------------- Startup trace --------------------------------------
+// Timestamps for one-off init phases (config load, glfwInit, windows, GLAD, ImGui, first frame...).
+// mark() may be called from any thread; names must be string literals.
+class StartupTrace {
+public:
+    static constexpr int CAPACITY = 32;
+
+    StartupTrace(){ startNs_ = FrameProfiler::now_ns(); }
+
+    void mark(const char* phase){
+        int i = count_.fetch_add(1, std::memory_order_relaxed);
+        if(i >= CAPACITY) return;
+        marks_[i].name = phase; marks_[i].ns = FrameProfiler::now_ns();
+        marks_[i].ready.store(true, std::memory_order_release);
+    }
+
+    // Milliseconds from trace start to the first mark named `phase` (-1 if not reached).
+    double at(const char* phase) const {
+        for(int i = 0; i < size(); i++)
+            if(marks_[i].ready.load(std::memory_order_acquire) && strcmp(marks_[i].name, phase) == 0) return (marks_[i].ns - startNs_) / 1e6;
+        return -1.0;
+    }
+
+    // One line per phase: time spent since the previous mark and time since start.
+    void print(FILE* out) const {
+        uint64_t prev = startNs_;
+        fprintf(out, "Startup trace:\n");
+        for(int i = 0; i < size(); i++){
+            if(!marks_[i].ready.load(std::memory_order_acquire)) continue;
+            fprintf(out, "  %-24s +%8.2f ms  @ %8.2f ms\n", marks_[i].name, (marks_[i].ns - prev) / 1e6, (marks_[i].ns - startNs_) / 1e6);
+            prev = marks_[i].ns;
+        }
+    }
+
+    // Chrome trace: each phase as a slice from the previous mark to its own.
+    bool write_chrome_trace(const char* path) const {
+        FILE* f = fopen(path, "w");
+        if(!f) return false;
+        fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+        uint64_t prev = startNs_; bool first = true;
+        for(int i = 0; i < size(); i++){
+            if(!marks_[i].ready.load(std::memory_order_acquire)) continue;
+            fprintf(f, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}", first ? "" : ",\n",
+                marks_[i].name, (prev - startNs_) / 1e3, (marks_[i].ns - prev) / 1e3);
+            prev = marks_[i].ns; first = false;
+        }
+        fprintf(f, "\n]}\n");
+        return fclose(f) == 0;
+    }
+
+private:
+    int size() const { int n = count_.load(std::memory_order_relaxed); return n < CAPACITY ? n : CAPACITY; }
+
+    struct Mark { const char* name = ""; uint64_t ns = 0; std::atomic<bool> ready{false}; };
+    Mark marks_[CAPACITY];
+    std::atomic<int> count_{0};
+    uint64_t startNs_ = 0;
+};
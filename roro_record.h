@@ -0,0 +1,298 @@
+// roro_record.h
+// Roro Client - binary session recording and headless replay
+// ---------------------------------------------------------------------------
+// A recording is what the overlay saw during a play session: every input edge it drained and
+// every overlay loop iteration (presented or skipped), in order. Replaying it drives the same
+// CPS / keystroke / FPS code the overlay runs live, without a window and as fast as the CPU
+// allows, so a real session becomes a repeatable benchmark and correctness fixture.
+// File layout (host byte order, little-endian on every target we build for), append-only:
+//   RecordingHeader (24 bytes), then RecordEntry (8 bytes each) until end of file.
+// Keys already held when recording starts are a bitmask in the header, not edges: replay starts
+// from that state without counting those presses as clicks.
+// Entry times are deltas in microseconds from the previous entry; a gap too long for 32 bits is
+// split with RECORD_GAP entries. A torn last entry (crash mid-write) is ignored when reading.
+// The recorder buffers a block of entries and writes it unbuffered when full: no allocation
+// and one write every few seconds on the overlay thread.
+// ---------------------------------------------------------------------------
+#pragma once
+
+#include "roro_clickstats.h"
+#include "roro_input.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// ------------------------------- Shared HUD logic ----------------------------------
+// The overlay and replay both go through these, so a replay is the live code path.
+
+// Input edge -> click stats (left and right button presses count as clicks).
+inline void count_click_edge(ClickStats &clicks, const InputEvent &ev){
+    if(!ev.down) return;
+    if(ev.code == INPUT_LBUTTON) clicks.click(CLICK_LEFT, ev.timeNs);
+    else if(ev.code == INPUT_RBUTTON) clicks.click(CLICK_RIGHT, ev.timeNs);
+}
+
+// FPS over half-second windows, counting presented frames. The share of loop iterations that
+// skipped presenting (render-on-change) is measured over the same window.
+class FpsCounter {
+public:
+    static constexpr uint64_t WINDOW_NS = 500000000ull;
+
+    void restart(uint64_t nowNs){ startNs_ = nowNs; presented_ = skipped_ = 0; }
+
+    // Once per loop iteration, before it presents or skips. True when fps()/skipRatio() were
+    // just refreshed.
+    bool update(uint64_t nowNs){
+        if(!startNs_){ restart(nowNs); return false; }
+        if(nowNs < startNs_ + WINDOW_NS) return false;
+        fps_ = (float)(presented_ * 1e9 / (double)(nowNs - startNs_));
+        uint32_t n = presented_ + skipped_;
+        skipRatio_ = n ? (float)skipped_ / n : 0.0f;
+        restart(nowNs);
+        return true;
+    }
+    void presented(){ presented_++; }
+    void skipped(){ skipped_++; }
+
+    float fps() const { return fps_; }
+    float skipRatio() const { return skipRatio_; }
+
+private:
+    uint64_t startNs_ = 0;
+    uint32_t presented_ = 0, skipped_ = 0;
+    float fps_ = 0.0f, skipRatio_ = 0.0f;
+};
+
+// ------------------------------- Format -------------------------------------------
+enum RecordType : uint8_t {
+    RECORD_INPUT = 1,  // code = InputCode, value = 1 down / 0 up
+    RECORD_FRAME,      // overlay loop iteration: code = 1 if presented, value = busy time in us (saturated)
+    RECORD_RESUME,     // overlay shown again after idling (live FPS state restarted)
+    RECORD_GAP,        // time only
+    RECORD_IDLE        // overlay went idle: edges so far counted, held keys forgotten
+};
+
+struct RecordEntry {
+    uint32_t deltaUs;  // since the previous entry (or the header's startNs)
+    uint8_t type;      // RecordType
+    uint8_t code;
+    uint16_t value;
+};
+static_assert(sizeof(RecordEntry) == 8, "RecordEntry is a fixed 8-byte record");
+
+struct RecordingHeader {
+    char magic[4];     // "RREC"
+    uint16_t version;
+    uint16_t entrySize;
+    uint64_t startNs;  // steady_clock time the first delta counts from
+    uint32_t held;     // bit per InputCode held at startNs (always 0 in version 1 files)
+    uint32_t reserved;
+};
+static_assert(sizeof(RecordingHeader) == 24, "RecordingHeader is 24 bytes on disk");
+
+static const char RECORDING_MAGIC[4] = { 'R', 'R', 'E', 'C' };
+static constexpr uint16_t RECORDING_VERSION = 2; // 1: held keys were written as down edges
+
+// ------------------------------- Recorder -----------------------------------------
+// Overlay thread only. Entries must be appended in the order the overlay handled them; an edge
+// stamped before the previous entry is clamped onto it.
+class SessionRecorder {
+public:
+    static constexpr uint32_t BLOCK = 512; // entries buffered between writes (4 KB)
+
+    ~SessionRecorder(){ stop(); }
+
+    // Keys already held at `startNs` go in the header so replay starts from the same state.
+    bool start(const char* path, uint64_t startNs, const InputState &held){
+        stop();
+        f_ = fopen(path, "wb");
+        if(!f_) return false;
+        setvbuf(f_, NULL, _IONBF, 0); // whole blocks only; no stdio buffer to allocate or copy through
+        RecordingHeader h; memset(&h, 0, sizeof(h));
+        memcpy(h.magic, RECORDING_MAGIC, 4); h.version = RECORDING_VERSION; h.entrySize = sizeof(RecordEntry);
+        h.startNs = startNs;
+        for(uint8_t c = 0; c < INPUT_CODE_COUNT; c++) if(held.down[c]) h.held |= 1u << c;
+        if(fwrite(&h, sizeof(h), 1, f_) != 1){ fclose(f_); f_ = nullptr; return false; }
+        lastNs_ = startNs; count_ = 0; written_ = 0; frameOpen_ = false; failed_ = false;
+        return true;
+    }
+
+    void stop(){
+        if(!f_) return;
+        flush();
+        if(fclose(f_) != 0) failed_ = true;
+        f_ = nullptr;
+    }
+
+    bool active() const { return f_ != nullptr; }
+    bool failed() const { return failed_; }           // a write failed; the file is truncated there
+    uint64_t entries() const { return written_ + count_; }
+
+    void input(const InputEvent &ev){ if(f_) append(ev.timeNs, RECORD_INPUT, ev.code, ev.down); }
+
+    // An overlay loop iteration, at the time its CPS and FPS were evaluated. Whether it presented
+    // is filled in by endFrame() once known.
+    void frame(uint64_t nowNs){
+        if(!f_) return;
+        append(nowNs, RECORD_FRAME, 0, 0);
+        frameOpen_ = true;
+    }
+    void endFrame(bool presented, uint64_t busyNs){
+        if(!f_ || !frameOpen_) return;
+        // still in the block: flushing only happens ahead of an append
+        RecordEntry &e = block_[count_ - 1];
+        uint64_t us = busyNs / 1000;
+        e.code = presented ? 1 : 0; e.value = (uint16_t)(us > 0xffff ? 0xffff : us);
+        frameOpen_ = false;
+    }
+
+    // The overlay went idle after draining the ring (those edges go through input() first).
+    void idle(uint64_t nowNs){ if(f_) append(nowNs, RECORD_IDLE, 0, 0); }
+    void resume(uint64_t nowNs){ if(f_) append(nowNs, RECORD_RESUME, 0, 0); }
+
+private:
+    void append(uint64_t tNs, uint8_t type, uint8_t code, uint16_t value){
+        uint64_t us = tNs > lastNs_ ? (tNs - lastNs_) / 1000 : 0;
+        lastNs_ += us * 1000; // track the quantized time so rounding never accumulates
+        while(us > 0xffffffffull){ push(0xffffffffu, RECORD_GAP, 0, 0); us -= 0xffffffffull; }
+        push((uint32_t)us, type, code, value);
+        frameOpen_ = false;
+    }
+    void push(uint32_t deltaUs, uint8_t type, uint8_t code, uint16_t value){
+        if(count_ == BLOCK) flush();
+        RecordEntry &e = block_[count_++];
+        e.deltaUs = deltaUs; e.type = type; e.code = code; e.value = value;
+    }
+    void flush(){
+        if(!count_) return;
+        if(!failed_ && fwrite(block_, sizeof(RecordEntry), count_, f_) != count_) failed_ = true;
+        written_ += count_; count_ = 0;
+    }
+
+    FILE* f_ = nullptr;
+    RecordEntry block_[BLOCK];
+    uint32_t count_ = 0;
+    uint64_t written_ = 0, lastNs_ = 0;
+    bool frameOpen_ = false, failed_ = false;
+};
+
+// ------------------------------- Reader -------------------------------------------
+struct Recording {
+    RecordingHeader header;
+    std::vector<RecordEntry> entries;
+};
+
+// False if the file is missing or not a recording this build understands. Version 1 files still
+// read; their held keys are down edges and replay counts them as it always did.
+inline bool read_recording(const char* path, Recording &out){
+    FILE* f = fopen(path, "rb");
+    if(!f) return false;
+    bool ok = fread(&out.header, sizeof(out.header), 1, f) == 1
+        && memcmp(out.header.magic, RECORDING_MAGIC, 4) == 0
+        && (out.header.version == 1 || out.header.version == RECORDING_VERSION) && out.header.entrySize == sizeof(RecordEntry);
+    out.entries.clear();
+    if(ok){
+        if(out.header.version == 1) out.header.held = 0;
+        // Read in chunks up to end of file: no file-size query, so no 32-bit long offsets on Windows.
+        const size_t CHUNK = 1u << 16;
+        size_t n = 0, got;
+        do {
+            out.entries.resize(n + CHUNK);
+            got = fread(out.entries.data() + n, sizeof(RecordEntry), CHUNK, f);
+            n += got;
+        } while(got == CHUNK);
+        out.entries.resize(n); // a torn last entry is not a whole item, so fread leaves it out
+    }
+    fclose(f);
+    return ok;
+}
+
+// ------------------------------- Replay -------------------------------------------
+// What the HUD showed on one replayed loop iteration.
+struct ReplayFrame {
+    uint64_t timeNs = 0;
+    bool presented = false;
+    uint16_t busyUs = 0;
+    float fps = 0.0f;
+    const ClickStats* clicks = nullptr;
+    const InputState* input = nullptr;
+};
+
+struct ReplayStats {
+    uint64_t frames = 0, presented = 0, edges = 0;
+    uint64_t durationNs = 0;                          // recorded wall time covered
+    uint64_t clicks[CLICK_BUTTON_COUNT] = {};
+    int peakCps[CLICK_BUTTON_COUNT] = {};
+    float minFps = 0.0f, maxFps = 0.0f, lastFps = 0.0f; // over the half-second FPS readings
+    uint64_t heldFrames[INPUT_CODE_COUNT] = {};       // iterations each input was held
+    uint64_t checksum = 0;                            // FNV-1a over every iteration's HUD values
+};
+
+// Feeds `rec` through the overlay's input drain, click stats and FPS counter in recorded order.
+// onFrame(const ReplayFrame&) sees every loop iteration.
+template<typename F>
+ReplayStats replay_recording(const Recording &rec, F &&onFrame){
+    ReplayStats s;
+    static thread_local InputRing ring;     // 16 KB and 8 KB: kept off the stack, and both
+    static thread_local ClickStats clicks;  // start empty (the ring is drained at the end)
+    InputState input; FpsCounter fps; clicks.reset();
+    uint64_t hash = 1469598103934665603ull;
+    auto mix = [&hash](uint64_t v){ for(int i = 0; i < 8; i++){ hash ^= (v >> (i * 8)) & 0xff; hash *= 1099511628211ull; } };
+    auto drain = [&]{ s.edges += input.drain(ring, [&](const InputEvent &ev){ count_click_edge(clicks, ev); }); };
+
+    for(int c = 0; c < INPUT_CODE_COUNT; c++) input.down[c] = (rec.header.held >> c) & 1; // held, not pressed
+
+    uint64_t t = rec.header.startNs;
+    bool anyFps = false;
+    for(const RecordEntry &e : rec.entries){
+        t += (uint64_t)e.deltaUs * 1000;
+        if(e.type == RECORD_INPUT){
+            InputEvent ev; ev.timeNs = t; ev.code = e.code; ev.down = e.value ? 1 : 0;
+            if(!ring.push(ev)){ drain(); ring.push(ev); }
+        } else if(e.type == RECORD_FRAME){
+            drain();
+            clicks.update(t);
+            if(fps.update(t)){
+                float v = fps.fps();
+                if(!anyFps || v < s.minFps) s.minFps = v;
+                if(!anyFps || v > s.maxFps) s.maxFps = v;
+                s.lastFps = v; anyFps = true;
+            }
+            bool presented = e.code != 0;
+            if(presented){ fps.presented(); s.presented++; } else fps.skipped();
+            s.frames++;
+            uint32_t held = 0;
+            for(int c = 0; c < INPUT_CODE_COUNT; c++) if(input.down[c]){ s.heldFrames[c]++; held |= 1u << c; }
+            mix(((uint64_t)held << 1) | (presented ? 1 : 0));
+            mix((uint64_t)clicks.count(CLICK_LEFT) | ((uint64_t)clicks.count(CLICK_RIGHT) << 32));
+            float f = fps.fps(); uint32_t fbits; memcpy(&fbits, &f, 4); mix(fbits);
+            ReplayFrame rf; rf.timeNs = t; rf.presented = presented; rf.busyUs = e.value; rf.fps = f; rf.clicks = &clicks; rf.input = &input;
+            onFrame(rf);
+        } else if(e.type == RECORD_IDLE){
+            drain();
+            input = InputState(); // as the overlay does: releases while idle are never seen
+        } else if(e.type == RECORD_RESUME){
+            fps.restart(t);
+        }
+    }
+    drain();
+    for(int b = 0; b < CLICK_BUTTON_COUNT; b++){ s.clicks[b] = clicks.total((ClickButton)b); s.peakCps[b] = clicks.peak((ClickButton)b); }
+    s.durationNs = t - rec.header.startNs;
+    s.checksum = hash;
+    return s;
+}
+inline ReplayStats replay_recording(const Recording &rec){ return replay_recording(rec, [](const ReplayFrame&){}); }
+
+inline void print_replay_stats(const ReplayStats &s, FILE* out){
+    static const char* names[INPUT_CODE_COUNT] = { "W", "A", "S", "D", "Space", "LMB", "RMB" };
+    fprintf(out, "Replay: %.1f s recorded, %llu loop iterations (%llu presented), %llu input edges\n",
+        s.durationNs / 1e9, (unsigned long long)s.frames, (unsigned long long)s.presented, (unsigned long long)s.edges);
+    fprintf(out, "  clicks  L %llu (peak %d CPS)  R %llu (peak %d CPS)\n",
+        (unsigned long long)s.clicks[CLICK_LEFT], s.peakCps[CLICK_LEFT], (unsigned long long)s.clicks[CLICK_RIGHT], s.peakCps[CLICK_RIGHT]);
+    fprintf(out, "  fps     min %.1f  max %.1f  last %.1f\n", s.minFps, s.maxFps, s.lastFps);
+    fprintf(out, "  held   ");
+    for(int c = 0; c < INPUT_CODE_COUNT; c++) fprintf(out, " %s %.1f%%", names[c], s.frames ? 100.0 * s.heldFrames[c] / s.frames : 0.0);
+    fprintf(out, "\n  checksum %016llx\n", (unsigned long long)s.checksum);
+}
@@ -0,0 +1,202 @@
+// roro_texture_cache.h
+// Roro Client - background image decode off the UI thread, with a size-matched raw cache
+// ---------------------------------------------------------------------------
+// The launcher background is shown stretched over a small window, so decoding a full-size
+// wallpaper and uploading it at source resolution wastes startup time and VRAM. Here the image
+// is decoded on a worker thread, box-filtered down to the target (framebuffer) size and written
+// to roro_cache/ as raw RGBA keyed on source path, mtime and target size. Later launches with
+// the same key read that file straight into memory and skip JPEG/PNG decoding entirely.
+// Keys of edited, resized or replaced images are never asked for again, so the directory is kept
+// under IMAGE_CACHE_MAX_BYTES by dropping the least recently used entries.
+// The GL upload itself stays on the thread that owns the context (see AsyncImageLoader::ready).
+// ---------------------------------------------------------------------------
+#pragma once
+
+#include "roro_persist.h" // write_file_atomic
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct DecodedImage {
+    int w = 0, h = 0;
+    std::vector<unsigned char> rgba;
+    bool fromCache = false;
+};
+
+static const char* IMAGE_CACHE_DIR = "roro_cache";
+static const uintmax_t IMAGE_CACHE_MAX_BYTES = 32ull << 20; // a few full-HD backgrounds
+
+// ------------------------------- Raw cache file -------------------------------------
+// [RawImageHeader][w*h*4 bytes RGBA]
+struct RawImageHeader {
+    char magic[4];      // "RIMG"
+    uint32_t version;
+    uint64_t key;
+    uint32_t w, h;
+};
+static const uint32_t RAW_IMAGE_VERSION = 1;
+
+inline uint64_t fnv1a64(const void* data, size_t n, uint64_t h = 1469598103934665603ull){
+    const unsigned char* p = (const unsigned char*)data;
+    for(size_t i = 0; i < n; i++){ h ^= p[i]; h *= 1099511628211ull; }
+    return h;
+}
+
+// Cache key: source path + source mtime + requested size. Returns 0 if the source is missing.
+inline uint64_t image_cache_key(const std::string &path, int targetW, int targetH){
+    std::error_code ec;
+    auto mtime = std::filesystem::last_write_time(path, ec);
+    if(ec) return 0;
+    int64_t t = (int64_t)mtime.time_since_epoch().count();
+    uint64_t h = fnv1a64(path.data(), path.size());
+    h = fnv1a64(&t, sizeof(t), h);
+    h = fnv1a64(&targetW, sizeof(targetW), h);
+    return fnv1a64(&targetH, sizeof(targetH), h);
+}
+
+inline std::string image_cache_path(uint64_t key){
+    char name[64]; snprintf(name, sizeof(name), "/img_%016llx.rgba", (unsigned long long)key);
+    return std::string(IMAGE_CACHE_DIR) + name;
+}
+
+inline bool read_image_cache(const std::string &file, uint64_t key, DecodedImage &out){
+    FILE* f = fopen(file.c_str(), "rb");
+    if(!f) return false;
+    RawImageHeader hdr;
+    bool ok = fread(&hdr, sizeof(hdr), 1, f) == 1 && memcmp(hdr.magic, "RIMG", 4) == 0
+           && hdr.version == RAW_IMAGE_VERSION && hdr.key == key && hdr.w && hdr.h && hdr.w <= 16384 && hdr.h <= 16384;
+    if(ok){
+        out.w = (int)hdr.w; out.h = (int)hdr.h;
+        out.rgba.resize((size_t)hdr.w * hdr.h * 4);
+        ok = fread(out.rgba.data(), 1, out.rgba.size(), f) == out.rgba.size();
+    }
+    fclose(f);
+    return ok;
+}
+
+inline void write_image_cache(const std::string &file, uint64_t key, const DecodedImage &img){
+    RawImageHeader hdr; memcpy(hdr.magic, "RIMG", 4);
+    hdr.version = RAW_IMAGE_VERSION; hdr.key = key; hdr.w = (uint32_t)img.w; hdr.h = (uint32_t)img.h;
+    std::string data((const char*)&hdr, sizeof(hdr));
+    data.append((const char*)img.rgba.data(), img.rgba.size());
+    std::error_code ec; std::filesystem::create_directories(IMAGE_CACHE_DIR, ec);
+    write_file_atomic(file, data);
+}
+
+// Deletes cache entries, least recently used first (a hit refreshes the file's mtime), until the
+// directory holds at most maxBytes. `keep` (the entry just used) is never deleted.
+inline void prune_image_cache(const std::string &keep, uintmax_t maxBytes = IMAGE_CACHE_MAX_BYTES){
+    struct Entry { std::filesystem::path path; std::filesystem::file_time_type used; uintmax_t size; };
+    std::vector<Entry> entries; uintmax_t total = 0;
+    std::error_code ec;
+    for(std::filesystem::directory_iterator it(IMAGE_CACHE_DIR, ec), end; !ec && it != end; it.increment(ec)){
+        std::string name = it->path().filename().string();
+        if(name.compare(0, 4, "img_") != 0) continue; // img_<key>.rgba, and .tmp left by a crash
+        Entry e; e.path = it->path(); e.size = it->file_size(ec); e.used = it->last_write_time(ec);
+        if(ec){ ec.clear(); continue; }
+        total += e.size;
+        if(e.path != std::filesystem::path(keep)) entries.push_back(e);
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b){ return a.used < b.used; });
+    for(const Entry &e : entries){
+        if(total <= maxBytes) break;
+        if(std::filesystem::remove(e.path, ec)) total -= e.size;
+    }
+}
+
+// ------------------------------- Downscale ------------------------------------------
+// Area-average (box) filter; every source pixel contributes to exactly one destination pixel.
+inline void downscale_rgba_box(const unsigned char* src, int sw, int sh, unsigned char* dst, int dw, int dh){
+    for(int dy = 0; dy < dh; dy++){
+        int y0 = (int)((int64_t)dy * sh / dh), y1 = (int)((int64_t)(dy + 1) * sh / dh);
+        if(y1 <= y0) y1 = y0 + 1;
+        for(int dx = 0; dx < dw; dx++){
+            int x0 = (int)((int64_t)dx * sw / dw), x1 = (int)((int64_t)(dx + 1) * sw / dw);
+            if(x1 <= x0) x1 = x0 + 1;
+            uint32_t acc[4] = {0,0,0,0};
+            for(int y = y0; y < y1; y++){
+                const unsigned char* row = src + ((size_t)y * sw + x0) * 4;
+                for(int x = x0; x < x1; x++, row += 4){ acc[0] += row[0]; acc[1] += row[1]; acc[2] += row[2]; acc[3] += row[3]; }
+            }
+            uint32_t n = (uint32_t)((y1 - y0) * (x1 - x0));
+            unsigned char* o = dst + ((size_t)dy * dw + dx) * 4;
+            for(int c = 0; c < 4; c++) o[c] = (unsigned char)((acc[c] + n / 2) / n);
+        }
+    }
+}
+
+// Decode `path` fitted to at most targetW x targetH (never upscaled), going through the cache.
+inline bool decode_image_fitted(const std::string &path, int targetW, int targetH, DecodedImage &out){
+    uint64_t key = image_cache_key(path, targetW, targetH);
+    if(!key) return false;
+    std::string cacheFile = image_cache_path(key);
+    if(read_image_cache(cacheFile, key, out)){
+        std::error_code ec;
+        std::filesystem::last_write_time(cacheFile, std::filesystem::file_time_type::clock::now(), ec); // mark used
+        prune_image_cache(cacheFile);
+        out.fromCache = true;
+        return true;
+    }
+
+    int w, h, n;
+    unsigned char* data = stbi_load(path.c_str(), &w, &h, &n, 4);
+    if(!data) return false;
+    if(targetW > 0 && targetH > 0 && (w > targetW || h > targetH)){
+        out.w = w < targetW ? w : targetW; out.h = h < targetH ? h : targetH;
+        out.rgba.resize((size_t)out.w * out.h * 4);
+        downscale_rgba_box(data, w, h, out.rgba.data(), out.w, out.h);
+    } else {
+        out.w = w; out.h = h;
+        out.rgba.assign(data, data + (size_t)w * h * 4);
+    }
+    stbi_image_free(data);
+    out.fromCache = false;
+    write_image_cache(cacheFile, key, out);
+    prune_image_cache(cacheFile);
+    return true;
+}
+
+// ------------------------------- Async loader ---------------------------------------
+// start() decodes on a worker; the owning thread polls ready() each frame and uploads once.
+class AsyncImageLoader {
+public:
+    ~AsyncImageLoader(){ if(worker_.joinable()) worker_.join(); }
+
+    // onDone runs on the worker when the result is available (e.g. glfwPostEmptyEvent).
+    void start(const std::string &path, int targetW, int targetH, std::function<void()> onDone = nullptr){
+        if(worker_.joinable()) return;
+        worker_ = std::thread([this, path, targetW, targetH, onDone]{
+            ok_ = decode_image_fitted(path, targetW, targetH, image_);
+            done_.store(true, std::memory_order_release);
+            if(onDone) onDone();
+        });
+    }
+
+    // True once, when a decoded image is ready to upload; `out` then owns the pixels.
+    bool ready(DecodedImage &out){
+        if(taken_ || !done_.load(std::memory_order_acquire)) return false;
+        taken_ = true;
+        worker_.join();
+        if(!ok_) return false;
+        out = std::move(image_);
+        return true;
+    }
+
+    bool pending() const { return worker_.joinable() && !taken_; }
+
+private:
+    std::thread worker_;
+    std::atomic<bool> done_{false};
+    bool ok_ = false, taken_ = false;
+    DecodedImage image_;
+};
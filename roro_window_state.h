@@ -0,0 +1,132 @@
+// roro_window_state.h
+// Roro Client - overlay window state, applied to the platform only when it changes
+// ---------------------------------------------------------------------------
+// The overlay wants the same window state every frame (topmost, click-through, layered, and
+// optionally a size/position). Re-applying it each frame means a SetWindowPos and a
+// GetWindowLong/SetWindowLong round trip per frame, all visible to the compositor. A
+// WindowStateCache remembers what was last applied through a WindowBackend and issues only
+// the calls whose state differs.
+// - Windows: Win32WindowBackend (SetWindowPos / SetWindowLong on an HWND).
+// - Any:     MockWindowBackend, which applies nothing and counts calls (roro_bench --selftest).
+// ---------------------------------------------------------------------------
+#pragma once
+
+#include <cstdint>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#endif
+
+struct WindowState {
+    bool topmost = false;
+    bool clickThrough = false;  // mouse input passes through to the window below
+    bool layered = false;       // add WS_EX_LAYERED; false leaves whatever the window has
+    bool hasRect = false;       // leave size/position alone unless set
+    int x = 0, y = 0, w = 0, h = 0;
+};
+
+// ------------------------------- Platform interface --------------------------------
+// One method per independent platform call. Each returns false if the call failed, in which
+// case the cache does not record it as applied and retries on the next apply().
+class WindowBackend {
+public:
+    virtual ~WindowBackend() {}
+    virtual bool setTopmost(bool topmost) = 0;
+    virtual bool setExStyle(bool clickThrough, bool layered) = 0;
+    virtual bool setRect(int x, int y, int w, int h) = 0;
+};
+
+// ------------------------------- Cache ---------------------------------------------
+class WindowStateCache {
+public:
+    explicit WindowStateCache(WindowBackend &backend) : backend_(backend) {}
+
+    // Issues only the platform calls needed to go from the last applied state to `want`;
+    // returns how many were made. Anything not yet applied (first call, after invalidate(),
+    // or after a failed call) is applied regardless of what the cache holds.
+    int apply(const WindowState &want){
+        int calls = 0;
+        if(!topmostKnown_ || want.topmost != applied_.topmost){
+            calls++;
+            topmostKnown_ = backend_.setTopmost(want.topmost);
+            applied_.topmost = want.topmost;
+        }
+        if(!styleKnown_ || want.clickThrough != applied_.clickThrough || want.layered != applied_.layered){
+            calls++;
+            styleKnown_ = backend_.setExStyle(want.clickThrough, want.layered);
+            applied_.clickThrough = want.clickThrough; applied_.layered = want.layered;
+        }
+        if(want.hasRect && (!rectKnown_ || want.x != applied_.x || want.y != applied_.y || want.w != applied_.w || want.h != applied_.h)){
+            calls++;
+            rectKnown_ = backend_.setRect(want.x, want.y, want.w, want.h);
+            applied_.hasRect = true; applied_.x = want.x; applied_.y = want.y; applied_.w = want.w; applied_.h = want.h;
+        }
+        calls_ += (uint64_t)calls;
+        return calls;
+    }
+
+    // Forget what was applied (the window was recreated, or someone else changed its styles).
+    void invalidate(){ topmostKnown_ = styleKnown_ = rectKnown_ = false; }
+
+    const WindowState& applied() const { return applied_; }
+    uint64_t calls() const { return calls_; }
+
+private:
+    WindowBackend &backend_;
+    WindowState applied_;
+    bool topmostKnown_ = false, styleKnown_ = false, rectKnown_ = false;
+    uint64_t calls_ = 0;
+};
+
+// ------------------------------- Overlay ---------------------------------------------
+// The overlay's per-frame window update, shared by overlay_thread_main and the bench check.
+// `want` carries over between frames: the window turns layered the first time click-through is
+// used and stays that way. Returns the platform calls made.
+inline int apply_overlay_window(WindowStateCache &cache, WindowState &want, bool alwaysOnTop, bool clickThrough){
+    want.topmost = alwaysOnTop;
+    want.clickThrough = clickThrough;
+    want.layered = want.layered || clickThrough;
+    return cache.apply(want);
+}
+
+// ------------------------------- Mock ----------------------------------------------
+// Applies nothing; counts calls per kind so a run of N frames can be checked exactly.
+class MockWindowBackend : public WindowBackend {
+public:
+    bool setTopmost(bool topmost) override { topmostCalls++; state.topmost = topmost; return true; }
+    bool setExStyle(bool clickThrough, bool layered) override { styleCalls++; state.clickThrough = clickThrough; state.layered |= layered; return true; }
+    bool setRect(int x, int y, int w, int h) override { rectCalls++; state.hasRect = true; state.x = x; state.y = y; state.w = w; state.h = h; return true; }
+    int total() const { return topmostCalls + styleCalls + rectCalls; }
+
+    WindowState state; // what the "window" currently looks like
+    int topmostCalls = 0, styleCalls = 0, rectCalls = 0;
+};
+
+#ifdef _WIN32
+// ------------------------------- Win32 ---------------------------------------------
+// setExStyle is the GetWindowLong/SetWindowLong pair; only the transparent and layered bits are
+// touched, anything else GLFW set on the window is kept. WS_EX_LAYERED is only ever added: a
+// window that has it (e.g. from GLFW's transparent framebuffer) keeps it.
+class Win32WindowBackend : public WindowBackend {
+public:
+    explicit Win32WindowBackend(HWND hwnd) : hwnd_(hwnd) {}
+    bool setTopmost(bool topmost) override {
+        return SetWindowPos(hwnd_, topmost ? HWND_TOPMOST : HWND_NOTOPMOST, 0,0,0,0, SWP_NOMOVE|SWP_NOSIZE|SWP_NOACTIVATE) != 0;
+    }
+    bool setExStyle(bool clickThrough, bool layered) override {
+        LONG ex = GetWindowLong(hwnd_, GWL_EXSTYLE);
+        ex = clickThrough ? (ex | WS_EX_TRANSPARENT) : (ex & ~WS_EX_TRANSPARENT);
+        if(layered) ex |= WS_EX_LAYERED;
+        SetLastError(0);
+        return SetWindowLong(hwnd_, GWL_EXSTYLE, ex) != 0 || GetLastError() == 0;
+    }
+    bool setRect(int x, int y, int w, int h) override {
+        return SetWindowPos(hwnd_, NULL, x, y, w, h, SWP_NOZORDER|SWP_NOACTIVATE) != 0;
+    }
+private:
+    HWND hwnd_;
+};
+#endif